@@ -0,0 +1,215 @@
+#include "BatchEvaluator.h"
+
+#pragma region C++ Includes
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <climits>
+#pragma endregion
+
+#pragma region Constant Parameters
+#define EMPTY_CELL_VALUE 1	//	Same values as Field::GetMoveScore
+#define OWN_CELL_VALUE 2
+#define OPPONENT_CELL_VALUE -3
+#pragma endregion
+
+using namespace std;
+
+namespace
+{
+	__inline int CountCells(PositionMask mask)
+	{
+		//	SWAR population count, the same on every position, so it vectorizes
+		mask = mask - ((mask >> 1) & 0x5555555555555555ull);
+		mask = (mask & 0x3333333333333333ull) + ((mask >> 2) & 0x3333333333333333ull);
+		mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return (int)((mask * 0x0101010101010101ull) >> 56);
+	}
+
+	__inline PositionMask IsEmpty(PositionMask mask)
+	{
+		//	1 for no cells, without a 64-bit compare, which SSE2 doesn't have
+		return ((mask - 1) & ~mask) >> 63;
+	}
+}
+
+void PositionBatch::Add(const Board & board)
+{
+	assert(board.GetCellsCount() <= BatchEvaluator::MaxCellsCount);
+
+	PositionMask crossMask = 0;
+	PositionMask circleMask = 0;
+	for(int cell = 0; cell < board.GetCellsCount(); cell++)
+		if(board.Get(cell) == FG_Cross)
+			crossMask |= (PositionMask)1 << cell;
+		else if(board.Get(cell) == FG_Circle)
+			circleMask |= (PositionMask)1 << cell;
+
+	crosses.push_back(crossMask);
+	circles.push_back(circleMask);
+}
+
+void PositionBatch::Clear()
+{
+	crosses.clear();
+	circles.clear();
+}
+
+BatchEvaluator::BatchEvaluator(const BoardRules & rules, int threadsCount) :
+	rules(rules),
+	cellsCount(rules.columns * rules.rows)
+{
+	assert(IsSupported(rules));
+
+	fullMask = cellsCount >= 64 ? ~(PositionMask)0 : ((PositionMask)1 << cellsCount) - 1;
+
+	//	Every run of cells long enough to win, as a mask and as a list of cells
+	const Board board(rules);
+	for(int cell = 0; cell < cellsCount; cell++)
+		for(int direction = 0; direction < Board::DirectionsCount; direction++)
+		{
+			const int rowStep = Board::Directions[direction][0];
+			const int colStep = Board::Directions[direction][1];
+			const int row = board.GetRow(cell);
+			const int col = board.GetColumn(cell);
+			if(!board.IsInside(row + (rules.runLength - 1) * rowStep, col + (rules.runLength - 1) * colStep))
+				continue;
+
+			PositionMask runMask = 0;
+			for(int c = 0; c < rules.runLength; c++)
+			{
+				const int runCell = board.ToCell(row + c * rowStep, col + c * colStep);
+				runMask |= (PositionMask)1 << runCell;
+				runCells.push_back(runCell);
+			}
+			runMasks.push_back(runMask);
+		}
+
+	if(threadsCount <= 0)
+		threadsCount = ThreadPool::GetHardwareThreadsCount();
+	if(threadsCount > 1)
+		pool.reset(new ThreadPool(threadsCount));
+}
+
+void BatchEvaluator::Evaluate(const PositionBatch & batch, BatchResults & results) const
+{
+	assert(batch.crosses.size() == batch.circles.size());
+
+	const size_t count = batch.GetCount();
+	results.winners.resize(count);
+	results.legalMoves.resize(count);
+	results.bestMoves.resize(count);
+
+	const size_t blocksCount = (count + BlockSize - 1) / BlockSize;
+	if(!pool || blocksCount < 2)
+	{
+		for(size_t block = 0; block < blocksCount; block++)
+			EvaluateBlock(batch, block * BlockSize, results);
+		return;
+	}
+
+	//	Blocks are handed out one at a time, whoever is done first takes the next one
+	atomic<size_t> nextBlock(0);
+	pool->Run([&](int)
+	{
+		for(size_t block = nextBlock++; block < blocksCount; block = nextBlock++)
+			EvaluateBlock(batch, block * BlockSize, results);
+	});
+}
+
+void BatchEvaluator::EvaluateBlock(const PositionBatch & batch, size_t first, BatchResults & results) const
+{
+	/*
+	 * The last block is filled up with empty boards, so every
+	 * loop runs the same fixed count, they're just not written
+	 * back. Every loop over positions is free of branches.
+	 */
+	const int count = (int)min((size_t)BlockSize, batch.GetCount() - first);
+	PositionMask crosses[BlockSize] = { };
+	PositionMask circles[BlockSize] = { };
+	copy(batch.crosses.begin() + first, batch.crosses.begin() + first + count, crosses);
+	copy(batch.circles.begin() + first, batch.circles.begin() + first + count, circles);
+
+	//	Winners, a run full of one faction's glyphs
+	PositionMask crossWins[BlockSize] = { };
+	PositionMask circleWins[BlockSize] = { };
+	for(const PositionMask runMask : runMasks)
+		for(int p = 0; p < BlockSize; p++)
+		{
+			crossWins[p] |= IsEmpty(runMask & ~crosses[p]);
+			circleWins[p] |= IsEmpty(runMask & ~circles[p]);
+		}
+
+	//	The faction to move, the cross unless it has one more glyph
+	PositionMask own[BlockSize];
+	PositionMask opponent[BlockSize];
+	for(int p = 0; p < BlockSize; p++)
+	{
+		const PositionMask crossToMove = (PositionMask)0 - (PositionMask)(CountCells(crosses[p]) == CountCells(circles[p]));
+		own[p] = (crosses[p] & crossToMove) | (circles[p] & ~crossToMove);
+		opponent[p] = (circles[p] & crossToMove) | (crosses[p] & ~crossToMove);
+	}
+
+	/*
+	 * Each run is summed once from the values of its cells, and
+	 * each cell keeps the best sum of the runs through it: the
+	 * same scores as Field::GetMoveScore, which counts the cell
+	 * itself out of its runs, and counts only runs better than
+	 * none at all.
+	 */
+	int16_t values[MaxCellsCount][BlockSize];
+	int16_t bestSums[MaxCellsCount][BlockSize];
+	for(int cell = 0; cell < cellsCount; cell++)
+	{
+		for(int p = 0; p < BlockSize; p++)
+			values[cell][p] = (int16_t)(
+				EMPTY_CELL_VALUE +
+				(OWN_CELL_VALUE - EMPTY_CELL_VALUE) * (int16_t)((own[p] >> cell) & 1) +
+				(OPPONENT_CELL_VALUE - EMPTY_CELL_VALUE) * (int16_t)((opponent[p] >> cell) & 1)
+			);
+		fill(bestSums[cell], bestSums[cell] + BlockSize, (int16_t)SHRT_MIN);
+	}
+
+	const int runLength = rules.runLength;
+	for(size_t run = 0; run < runMasks.size(); run++)
+	{
+		const int * cells = &runCells[run * runLength];
+		int16_t sums[BlockSize];
+		for(int p = 0; p < BlockSize; p++)
+			sums[p] = values[cells[0]][p];
+		for(int c = 1; c < runLength; c++)
+			for(int p = 0; p < BlockSize; p++)
+				sums[p] = (int16_t)(sums[p] + values[cells[c]][p]);
+		for(int c = 0; c < runLength; c++)
+			for(int p = 0; p < BlockSize; p++)
+				bestSums[cells[c]][p] = max(bestSums[cells[c]][p], sums[p]);
+	}
+
+	//	The best empty cell (the only cells worth the empty value), the lowest one on ties, like Field::FindBestMove
+	const int16_t baseScore = (int16_t)-(2 * runLength - 1);
+	int16_t bestScores[BlockSize];
+	int16_t bestMoves[BlockSize];
+	for(int p = 0; p < BlockSize; p++)
+	{
+		bestScores[p] = (int16_t)(baseScore - 1);
+		bestMoves[p] = -1;
+	}
+	for(int cell = 0; cell < cellsCount; cell++)
+		for(int p = 0; p < BlockSize; p++)
+		{
+			const int16_t score = max(baseScore, (int16_t)(baseScore + bestSums[cell][p] - EMPTY_CELL_VALUE));
+			const bool better = values[cell][p] == EMPTY_CELL_VALUE && score > bestScores[p];
+			bestScores[p] = better ? score : bestScores[p];
+			bestMoves[p] = better ? (int16_t)cell : bestMoves[p];
+		}
+
+	//	Once over, there's nothing left to play
+	for(int p = 0; p < count; p++)
+	{
+		const PositionMask emptyCells = ~(crosses[p] | circles[p]) & fullMask;
+		const bool over = crossWins[p] || circleWins[p] || emptyCells == 0;
+		results.winners[first + p] = (uint8_t)(crossWins[p] ? FG_Cross : circleWins[p] ? FG_Circle : FG_None);
+		results.legalMoves[first + p] = over ? 0 : emptyCells;
+		results.bestMoves[first + p] = over ? (int8_t)-1 : (int8_t)bestMoves[p];
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <memory>
+#include <cstdint>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "ThreadPool.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "Board.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * A set of cells of a board with up to 64 cells, stored as bits:
+ * bit N represents the cell with linear index N.
+ */
+typedef uint64_t PositionMask;
+
+/*
+ * Many positions of boards of the same rules, stored as arrays
+ * of structures would be, but the other way around: one array
+ * per faction, holding the cells of each position, so the same
+ * field of many positions lies in contiguous memory and can be
+ * worked on many positions at a time.
+ * The faction to move is not stored, the cross always opens.
+ */
+struct PositionBatch
+{
+	vector<PositionMask> crosses;
+	vector<PositionMask> circles;
+
+	__inline size_t GetCount() const { return crosses.size(); }
+	void Add(const Board & board);
+	void Clear();
+};
+
+/*
+ * Outcome of each position of a batch, in the same order: its
+ * winner (FG_None while the game is on, or for a draw), the
+ * cells that can be played (none once the game is over) and the
+ * best move of the faction to move by Field::FindBestMove's
+ * heuristic (-1 once the game is over).
+ */
+struct BatchResults
+{
+	vector<uint8_t> winners;	//	FactionGlyph values
+	vector<PositionMask> legalMoves;
+	vector<int8_t> bestMoves;
+};
+
+/*
+ * Evaluates positions by the batch, for analysis and training
+ * jobs which go through millions of unrelated positions: no
+ * Field, no Board, just the masks of each position.
+ *
+ * Positions are evaluated in blocks of a fixed size, and within
+ * a block one step at a time for all of them: every run of cells
+ * long enough to win is checked against all the positions of the
+ * block, then the cells are scored run after run, as
+ * Field::GetMoveScore scores them, and the best cell of each
+ * position is kept. Loops go over the positions of the block,
+ * with no branches and a fixed count, so the compiler turns them
+ * into vector instructions.
+ * Blocks are shared among the threads of the evaluator, if it's
+ * given more than one, each taking the next block left, and the
+ * calling thread takes its share.
+ */
+class BatchEvaluator
+{
+	// Fields
+public:
+	static const int BlockSize = 64;	//	Positions evaluated together
+	static const int MaxCellsCount = 64;
+protected:
+private:
+	BoardRules rules;
+	int cellsCount;
+	PositionMask fullMask;
+	vector<PositionMask> runMasks;
+	vector<int> runCells;	//	runLength cells per run, in the order of runMasks
+	unique_ptr<ThreadPool> pool;	//	Only with more than one thread
+	// Constructors
+public:
+	//	Zero or less threads for one per hardware thread
+	BatchEvaluator(const BoardRules & rules, int threadsCount = 1);
+protected:
+private:
+	// Methods
+public:
+	void Evaluate(const PositionBatch & batch, BatchResults & results) const;
+	__inline const BoardRules & GetRules() const { return rules; }
+	__inline int GetThreadsCount() const { return pool ? pool->GetWorkersCount() : 1; }
+	__inline static bool IsSupported(const BoardRules & boardRules) { return boardRules.columns * boardRules.rows <= MaxCellsCount; }
+protected:
+private:
+	void EvaluateBlock(const PositionBatch & batch, size_t first, BatchResults & results) const;
+};
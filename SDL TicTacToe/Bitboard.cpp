@@ -0,0 +1,160 @@
+#include "Bitboard.h"
+
+#pragma region C++ Includes
+#include <cassert>
+#pragma endregion
+
+//	Out-of-class definition of the constexpr table, needed as long as it's used at runtime too
+constexpr CellsMask Bitboard::WinMasks[Bitboard::WinMasksCount];
+
+/*
+ * Each row tells where each cell goes when the board is
+ * transformed by that symmetry: identity, rotations by 90,
+ * 180 and 270 degrees clockwise, then horizontal, vertical,
+ * main diagonal and anti-diagonal reflections.
+ */
+
+const int Bitboard::cellsSymmetries[Bitboard::SymmetriesCount][Bitboard::CellsCount] =
+	{
+		{0, 1, 2, 3, 4, 5, 6, 7, 8},
+		{2, 5, 8, 1, 4, 7, 0, 3, 6},
+		{8, 7, 6, 5, 4, 3, 2, 1, 0},
+		{6, 3, 0, 7, 4, 1, 8, 5, 2},
+		{2, 1, 0, 5, 4, 3, 8, 7, 6},
+		{6, 7, 8, 3, 4, 5, 0, 1, 2},
+		{0, 3, 6, 1, 4, 7, 2, 5, 8},
+		{8, 5, 2, 7, 4, 1, 6, 3, 0}
+	};
+
+//	Rotations by 90 and 270 degrees undo each other, all other symmetries undo themselves
+const int Bitboard::inverseSymmetries[Bitboard::SymmetriesCount] = { 0, 3, 2, 1, 4, 5, 6, 7 };
+
+/*
+ * Transforming a board cell by cell and then encoding it is
+ * too slow to be done for every node of a search, so we
+ * precompute, for every possible 9-bit mask, its transformed
+ * mask under each symmetry and its base-3 digits: indexing
+ * a board then costs two lookups per faction.
+ */
+
+CellsMask Bitboard::masksSymmetries[Bitboard::SymmetriesCount][Bitboard::FullMask + 1];
+BoardIndex Bitboard::masksIndices[Bitboard::FullMask + 1];
+bool Bitboard::tablesInitialized = Bitboard::InitializeTables();
+
+bool Bitboard::InitializeTables()
+{
+	for(int mask = 0; mask <= FullMask; mask++)
+	{
+		int index = 0;
+		int digitWeight = 1;
+		for(int cell = 0; cell < CellsCount; cell++, digitWeight *= 3)
+			if(mask & CellBit(cell))
+				index += digitWeight;
+		masksIndices[mask] = (BoardIndex)index;
+
+		for(int symmetry = 0; symmetry < SymmetriesCount; symmetry++)
+		{
+			CellsMask transformedMask = 0;
+			for(int cell = 0; cell < CellsCount; cell++)
+				if(mask & CellBit(cell))
+					transformedMask |= CellBit(cellsSymmetries[symmetry][cell]);
+			masksSymmetries[symmetry][mask] = transformedMask;
+		}
+	}
+
+	return true;
+}
+
+bool Bitboard::Set(int cell, FactionGlyph glyph)
+{
+	assert(cell >= 0 && cell < CellsCount);
+	assert(glyph != FG_None);	//	Use Bitboard::Unset() to clear a cell
+
+	//	Check that the cell is not already taken
+	const CellsMask cellBit = CellBit(cell);
+	if(GetOccupied() & cellBit)
+		return false;
+
+	if(glyph == FG_Cross)
+		crossMask |= cellBit;
+	else
+		circleMask |= cellBit;
+
+	return true;
+}
+
+void Bitboard::Unset(int cell)
+{
+	assert(cell >= 0 && cell < CellsCount);
+
+	const CellsMask keepMask = (CellsMask)~CellBit(cell);
+	crossMask &= keepMask;
+	circleMask &= keepMask;
+}
+
+FactionGlyph Bitboard::Get(int cell) const
+{
+	assert(cell >= 0 && cell < CellsCount);
+
+	const CellsMask cellBit = CellBit(cell);
+	if(crossMask & cellBit)
+		return FG_Cross;
+	if(circleMask & cellBit)
+		return FG_Circle;
+	return FG_None;
+}
+
+int Bitboard::GetNthCell(CellsMask mask, int n)
+{
+	//	Drop the first n set bits, the lowest remaining one is the requested cell
+	for(; n > 0 && mask; n--)
+		mask = PopLowestCell(mask);
+
+	return LowestCell(mask);
+}
+
+BoardIndex Bitboard::GetCanonicalIndex(int * symmetry) const
+{
+	BoardIndex canonicalIndex = GetIndex();
+	int canonicalSymmetry = 0;
+
+	//	Identity is already accounted for, check all other symmetries
+	for(int s = 1; s < SymmetriesCount; s++)
+	{
+		const BoardIndex index = (BoardIndex)(
+			masksIndices[masksSymmetries[s][crossMask]] +
+			2 * masksIndices[masksSymmetries[s][circleMask]]
+		);
+		if(index < canonicalIndex)
+		{
+			canonicalIndex = index;
+			canonicalSymmetry = s;
+		}
+	}
+
+	if(symmetry)
+		*symmetry = canonicalSymmetry;
+	return canonicalIndex;
+}
+
+Bitboard Bitboard::Transform(int symmetry) const
+{
+	assert(symmetry >= 0 && symmetry < SymmetriesCount);
+
+	return Bitboard(masksSymmetries[symmetry][crossMask], masksSymmetries[symmetry][circleMask]);
+}
+
+Bitboard Bitboard::FromIndex(BoardIndex index)
+{
+	assert(index < IndicesCount);
+
+	//	Read base-3 digits from the lowest cell to the highest
+	Bitboard board;
+	for(int cell = 0; cell < CellsCount; cell++, index /= 3)
+		if(index % 3 == 1)
+			board.crossMask |= CellBit(cell);
+		else if(index % 3 == 2)
+			board.circleMask |= CellBit(cell);
+
+	return board;
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <cstdint>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#pragma endregion
+
+#pragma region Compiler Intrinsics
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#pragma endregion
+
+/*
+ * A set of cells stored as bits, where bit N represents the
+ * cell with linear index N (row * 3 + col).
+ */
+typedef uint16_t CellsMask;
+
+/*
+ * Base-3 encoding of a whole board, where digit N is the
+ * content of the cell with linear index N (0 for empty, 1
+ * for cross, 2 for circle). Every board has a unique index
+ * in the [0; 3^9) range, which makes it a perfect hash.
+ */
+typedef uint16_t BoardIndex;
+
+/*
+ * Compact representation of the 3x3 Tic-Tac-Toe grid.
+ * Instead of storing a glyph per cell, the board stores one
+ * occupancy mask per faction, so the most frequent queries
+ * (who won? is it full? which cells are free?) become a
+ * handful of bit operations instead of loops over cells.
+ *
+ * This class has no dependency on SDL or on rendering, it's
+ * just data, so it can be freely copied around by anybody
+ * who needs to speculate on moves without touching the
+ * actual game field.
+ */
+class Bitboard
+{
+	// Fields
+public:
+	static const int CellsCount = 9;
+	static const int WinMasksCount = 8;
+	static const CellsMask FullMask = (1 << CellsCount) - 1;
+	/*
+	 * Same as the old combos table, but each combo is folded into
+	 * a single mask: a faction owns a combo when all of the combo's
+	 * bits are set in its own mask.
+	 */
+	static constexpr CellsMask WinMasks[WinMasksCount] =
+		{
+			0x007,	//	0, 1, 2
+			0x038,	//	3, 4, 5
+			0x1C0,	//	6, 7, 8
+			0x049,	//	0, 3, 6
+			0x092,	//	1, 4, 7
+			0x124,	//	2, 5, 8
+			0x111,	//	0, 4, 8
+			0x054	//	2, 4, 6
+		};
+	static const int IndicesCount = 19683;	//	3^9
+	static const int SymmetriesCount = 8;	//	4 rotations, each one optionally mirrored
+protected:
+private:
+	static const int cellsSymmetries[SymmetriesCount][CellsCount];
+	static const int inverseSymmetries[SymmetriesCount];
+	static CellsMask masksSymmetries[SymmetriesCount][FullMask + 1];
+	static BoardIndex masksIndices[FullMask + 1];
+	static bool tablesInitialized;
+	CellsMask crossMask = 0;
+	CellsMask circleMask = 0;
+	// Constructors
+public:
+	Bitboard() { }
+	Bitboard(CellsMask crossMask, CellsMask circleMask) : crossMask(crossMask), circleMask(circleMask) { }
+protected:
+private:
+	// Methods
+public:
+	__inline void Clear() { crossMask = 0; circleMask = 0; }
+	bool Set(int cell, FactionGlyph glyph);
+	void Unset(int cell);
+	FactionGlyph Get(int cell) const;
+
+	__inline CellsMask GetMask(FactionGlyph glyph) const { return glyph == FG_Cross ? crossMask : glyph == FG_Circle ? circleMask : GetEmpty(); }
+	__inline CellsMask GetOccupied() const { return crossMask | circleMask; }
+	__inline CellsMask GetEmpty() const { return (CellsMask)(~GetOccupied() & FullMask); }
+	__inline bool IsFull() const { return GetOccupied() == FullMask; }
+	__inline bool IsEmpty() const { return GetOccupied() == 0; }
+	__inline bool IsGameOver() const { return IsFull() || GetWinner() != FG_None; }
+	__inline FactionGlyph GetWinner() const
+	{
+		if(IsWinningMask(crossMask))
+			return FG_Cross;
+		if(IsWinningMask(circleMask))
+			return FG_Circle;
+		return FG_None;
+	}
+
+	/*
+	 * Indexing and symmetries. Many positions are the same
+	 * position seen in a mirror or from another side of the
+	 * table: the canonical index is the lowest index among
+	 * all the symmetric variants of the board, so all of
+	 * them share the same canonical index. The optional
+	 * symmetry output tells which transformation maps this
+	 * board to its canonical variant.
+	 */
+
+	__inline BoardIndex GetIndex() const { return (BoardIndex)(masksIndices[crossMask] + 2 * masksIndices[circleMask]); }
+	BoardIndex GetCanonicalIndex(int * symmetry = nullptr) const;
+	Bitboard Transform(int symmetry) const;
+	static Bitboard FromIndex(BoardIndex index);
+	__inline static int TransformCell(int cell, int symmetry) { return cellsSymmetries[symmetry][cell]; }
+	__inline static int InverseTransformCell(int cell, int symmetry) { return cellsSymmetries[inverseSymmetries[symmetry]][cell]; }
+
+	/*
+	 * Static helpers to work on raw masks, useful to anybody
+	 * that wants to iterate or test cells without going through
+	 * a whole board. The most basic ones are constexpr, so they
+	 * can be used to generate data at compile time too.
+	 */
+
+	static constexpr bool IsWinningMask(CellsMask mask)
+	{
+		for(const CellsMask winMask : WinMasks)
+			if((mask & winMask) == winMask)
+				return true;
+		return false;
+	}
+	static constexpr CellsMask CellBit(int cell) { return (CellsMask)(1 << cell); }
+	static constexpr int CountCells(CellsMask mask)
+	{
+		//	SWAR population count, no need for hardware support on 16 bits
+		unsigned int bits = mask;
+		bits = bits - ((bits >> 1) & 0x5555u);
+		bits = (bits & 0x3333u) + ((bits >> 2) & 0x3333u);
+		bits = (bits + (bits >> 4)) & 0x0F0Fu;
+		return (int)((bits + (bits >> 8)) & 0x1Fu);
+	}
+	__inline static int LowestCell(CellsMask mask)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		return _BitScanForward(&index, mask) ? (int)index : -1;
+#else
+		return mask ? __builtin_ctz(mask) : -1;
+#endif
+	}
+	__inline static CellsMask PopLowestCell(CellsMask mask) { return (CellsMask)(mask & (mask - 1)); }
+	static int GetNthCell(CellsMask mask, int n);
+protected:
+private:
+	static bool InitializeTables();
+};
@@ -0,0 +1,151 @@
+#include "Board.h"
+
+#pragma region C++ Includes
+#include <algorithm>
+#include <cassert>
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Only half of the directions are needed, each line is walked
+ * both ways starting from the cell: horizontal, vertical, main
+ * diagonal and anti-diagonal.
+ */
+
+const int Board::Directions[Board::DirectionsCount][2] =
+	{
+		{0, 1},
+		{1, 0},
+		{1, 1},
+		{1, -1}
+	};
+
+Board::Board(const BoardRules & rules) :
+	rules(rules),
+	cells(rules.columns * rules.rows),
+	emptyCells(rules.columns * rules.rows),
+	emptyCellsSlots(rules.columns * rules.rows)
+{
+	assert(rules.columns > 0 && rules.rows > 0);
+	assert(rules.runLength > 0 && rules.runLength <= max(rules.columns, rules.rows));
+
+	Reset();
+}
+
+void Board::Reset()
+{
+	//	Fill the board with empty cells, each one in its own slot of the empty cells
+	fill(cells.begin(), cells.end(), FG_None);
+	emptyCells.resize(GetCellsCount());
+	for(int cell = 0; cell < GetCellsCount(); cell++)
+	{
+		emptyCells[cell] = cell;
+		emptyCellsSlots[cell] = cell;
+	}
+
+	winner = FG_None;
+	lastMove = -1;
+}
+
+bool Board::MakeMove(int cell, FactionGlyph glyph)
+{
+	assert(cell >= 0 && cell < GetCellsCount());
+	assert(glyph != FG_None);
+
+	//	Check that the cell is not already taken
+	if(cells[cell] != FG_None)
+		return false;
+
+	//	Fill the cell with the move's glyph
+	cells[cell] = glyph;
+	lastMove = cell;
+
+	/*
+	 * Remove the cell from the empty cells by moving the last
+	 * empty cell in its slot: order is not preserved, but it
+	 * takes constant time whatever the size of the board.
+	 */
+	const int slot = emptyCellsSlots[cell];
+	const int movedCell = emptyCells.back();
+	emptyCells[slot] = movedCell;
+	emptyCellsSlots[movedCell] = slot;
+	emptyCells.pop_back();
+
+	//	Only runs through this cell may have changed, check if any is long enough
+	if(winner == FG_None)
+		for(int direction = 0; direction < DirectionsCount; direction++)
+			if(CountRun(cell, direction, glyph) >= rules.runLength)
+			{
+				winner = glyph;
+				break;
+			}
+
+	return true;
+}
+
+void Board::UndoMove(int cell)
+{
+	assert(cell >= 0 && cell < GetCellsCount());
+	assert(cells[cell] != FG_None);
+
+	/*
+	 * Moves are meant to be undone in reverse order, so when a
+	 * move is undone, the game was surely on before that move.
+	 */
+	cells[cell] = FG_None;
+	winner = FG_None;
+	lastMove = -1;
+
+	//	Give the cell back a slot among the empty cells
+	emptyCellsSlots[cell] = (int)emptyCells.size();
+	emptyCells.push_back(cell);
+}
+
+int Board::CountRun(int cell, int direction, FactionGlyph glyph) const
+{
+	/*
+	 * Count the glyphs in a row through the given cell, along
+	 * the given direction, walking both ways from the cell.
+	 * The cell itself counts as one of the glyph, whatever it
+	 * contains, so the same function tells both the length of
+	 * an existing run and the length of the run a move would
+	 * make.
+	 */
+	const int rowStep = Directions[direction][0];
+	const int colStep = Directions[direction][1];
+	const int row = GetRow(cell);
+	const int col = GetColumn(cell);
+
+	int runLength = 1;
+	for(int r = row + rowStep, c = col + colStep; IsInside(r, c) && Get(r, c) == glyph; r += rowStep, c += colStep)
+		runLength++;
+	for(int r = row - rowStep, c = col - colStep; IsInside(r, c) && Get(r, c) == glyph; r -= rowStep, c -= colStep)
+		runLength++;
+
+	return runLength;
+}
+
+bool Board::IsWinningMove(int cell, FactionGlyph glyph) const
+{
+	if(cells[cell] != FG_None)
+		return false;
+
+	for(int direction = 0; direction < DirectionsCount; direction++)
+		if(CountRun(cell, direction, glyph) >= rules.runLength)
+			return true;
+
+	return false;
+}
+
+Bitboard Board::ToBitboard() const
+{
+	assert(IsClassic());	//	Bitboards only represent the classic 3x3 grid
+
+	Bitboard bitboard;
+	for(int cell = 0; cell < Bitboard::CellsCount; cell++)
+		if(cells[cell] != FG_None)
+			bitboard.Set(cell, cells[cell]);
+
+	return bitboard;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "Bitboard.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Grid of any size where two factions take turns placing their
+ * glyphs, and the first to line up enough glyphs wins (what is
+ * usually called an m,n,k-game: Tic-Tac-Toe is the 3,3,3 one,
+ * Gomoku is the 15,15,5 one).
+ * Cells are addressed by linear index (row * columns + col).
+ *
+ * Boards can be huge, so nothing here ever scans the whole grid:
+ * - a move can only complete runs passing through its own cell,
+ *		so after a move only the four lines (horizontal, vertical
+ *		and the two diagonals) through that cell are walked, and
+ *		only as far as the run goes, and the winner is cached
+ * - empty cells are kept in a dense list, paired with the slot
+ *		of each cell in that list, so cells are added and removed
+ *		in constant time and a random empty cell is one pick away
+ *
+ * Like the Bitboard, this class has no dependency on SDL, so it
+ * can be copied by anybody who needs to speculate on moves.
+ */
+class Board
+{
+	// Fields
+public:
+	static const int DirectionsCount = 4;
+	static const int Directions[DirectionsCount][2];	//	{row step, col step} of each line
+protected:
+private:
+	BoardRules rules;
+	vector<FactionGlyph> cells;
+	vector<int> emptyCells;
+	vector<int> emptyCellsSlots;
+	FactionGlyph winner = FG_None;
+	int lastMove = -1;
+	// Constructors
+public:
+	Board(const BoardRules & rules = BoardRules());
+protected:
+private:
+	// Methods
+public:
+	void Reset();
+	bool MakeMove(int cell, FactionGlyph glyph);
+	void UndoMove(int cell);
+
+	__inline const BoardRules & GetRules() const { return rules; }
+	__inline int GetColumns() const { return rules.columns; }
+	__inline int GetRows() const { return rules.rows; }
+	__inline int GetRunLength() const { return rules.runLength; }
+	__inline int GetCellsCount() const { return (int)cells.size(); }
+	__inline bool IsClassic() const { return rules.columns == 3 && rules.rows == 3 && rules.runLength == 3; }
+
+	__inline int ToCell(int row, int col) const { return row * rules.columns + col; }
+	__inline int GetRow(int cell) const { return cell / rules.columns; }
+	__inline int GetColumn(int cell) const { return cell % rules.columns; }
+	__inline bool IsInside(int row, int col) const { return row >= 0 && row < rules.rows && col >= 0 && col < rules.columns; }
+
+	__inline FactionGlyph Get(int cell) const { return cells[cell]; }
+	__inline FactionGlyph Get(int row, int col) const { return cells[ToCell(row, col)]; }
+	__inline const vector<int> & GetEmptyCells() const { return emptyCells; }
+	__inline int GetMovesCount() const { return GetCellsCount() - (int)emptyCells.size(); }
+	__inline int GetLastMove() const { return lastMove; }
+
+	__inline bool IsFull() const { return emptyCells.empty(); }
+	__inline FactionGlyph GetWinner() const { return winner; }
+	__inline bool IsGameOver() const { return winner != FG_None || IsFull(); }
+
+	int CountRun(int cell, int direction, FactionGlyph glyph) const;
+	bool IsWinningMove(int cell, FactionGlyph glyph) const;
+	Bitboard ToBitboard() const;
+protected:
+private:
+};
@@ -6,11 +6,24 @@
 
 #pragma region Engine Includes
 #include "Random.h"
+#include "Clock.h"
 #pragma endregion
 
-CPUTurnController::CPUTurnController(Difficulty initialDifficulty, Field & gameField, FactionGlyph factionGlyph) :
+#pragma region Game Includes
+#include "PerfectPlayTable.h"
+#pragma endregion
+
+DeepeningSettings CPUTurnController::defaultSettings;
+ThreatSettings CPUTurnController::defaultThreatSettings;
+const Tablebase * CPUTurnController::tablebase = nullptr;
+bool CPUTurnController::thinkingDelay = false;
+
+CPUTurnController::CPUTurnController(Difficulty initialDifficulty, Field & gameField, FactionGlyph factionGlyph, const DeepeningSettings & settings) :
 	ATurnController(factionGlyph),
-	gameField(gameField)
+	gameField(gameField),
+	delayEngine(Random::GetSeed() + factionGlyph),
+	searcher(settings),
+	threatSearcher(defaultThreatSettings)
 {
 	SetDifficulty(initialDifficulty);
 }
@@ -32,56 +45,148 @@ void CPUTurnController::SetDifficulty(Difficulty newDifficulty)
 			defenseChance = 0.25f;
 			offenseChance = 0.25f;
 			prioritizeWinningMove = false;
+			playPerfectMove = false;
 			break;
 		case Difficulty::Medium:
 			defenseChance = 0.75f;
 			offenseChance = 0.5f;
 			prioritizeWinningMove = true;
+			playPerfectMove = false;
 			break;
 		case Difficulty::Hard:
 			defenseChance = 1.0f;
 			offenseChance = 1.0f;
 			prioritizeWinningMove = true;
+			playPerfectMove = true;
 			break;
 		default:
 			assert(false);	//	Shouldn't happen unless a new difficulty is introduced and not handled
 			defenseChance = 0.25f;
 			offenseChance = 0.25f;
 			prioritizeWinningMove = false;
+			playPerfectMove = false;
 			break;
 	}
 }
 
-Uint32 CPUTurnController::GetTurnDuration(Difficulty difficulty)
+Uint32 CPUTurnController::GetTurnDuration()
 {
 	/*
 	 * Just giving random numbers to simulate that
-	 * the AI needs time to find out a move.
+	 * the AI needs time to find out a move. Hard
+	 * difficulty takes its time for real.
 	 */
+	Uint32 minDuration;
+	Uint32 maxDuration;
 	switch(difficulty)
 	{
 		case Difficulty::Easy:
-			return (Uint32)Random::Range(350, 650);
+			minDuration = 350u;
+			maxDuration = 650u;
+			break;
 		case Difficulty::Medium:
-			return (Uint32)Random::Range(650, 1050);
+			minDuration = 650u;
+			maxDuration = 1050u;
+			break;
 		case Difficulty::Hard:
-			return (Uint32)Random::Range(1000, 1600);
+			return 0u;
 		default:
 			assert(false);	//	Shouldn't happen unless a new difficulty is introduced and not handled
 			return 100u;
 	}
+
+	return minDuration + (Uint32)(((delayEngine() >> 32) * (maxDuration - minDuration)) >> 32);
 }
 
 void CPUTurnController::TurnOpeningOperations()
 {
-	turnEndTime = SDL_GetTicks64() + GetTurnDuration(difficulty);
+	turnEndTime = 0;
+	if(!thinkingDelay || Clock::Get().IsVirtualClock())
+		return;
+
+	const Uint32 turnDuration = GetTurnDuration();
+	if(turnDuration > 0u)
+	{
+		turnEndTime = Clock::Get().GetTicks() + turnDuration;
+		Clock::Get().RequestWakeUp(turnEndTime);
+	}
 }
 
 void CPUTurnController::TurnUpdateOperations()
 {
 	/*
-	 * A good implementation of the AI for this game
-	 * would have been the mnimax algorithm.
+	 * Start thinking on the first update of the turn, rather than
+	 * when it opens: when starting over, the first turn opens
+	 * before the field is reset. From then on nothing changes the
+	 * field until the move is made or the turn is called off
+	 * (which waits for the calculation to be over), so it's safe
+	 * to read it from the background.
+	 */
+	if(!thinking.IsRunning())
+	{
+		//	Read here, the thinking may run on a thread of its own, with a clock of its own
+		const bool virtualTime = Clock::Get().IsVirtualClock();
+		thinking.Start([this, virtualTime](const atomic<bool> & cancelled) { return FindMove(cancelled, virtualTime); });
+	}
+
+	//	Wait until the turn ends (faking the AI's speculations, if the move is found earlier)
+	if(Clock::Get().GetTicks() < turnEndTime)
+	{
+		Clock::Get().RequestWakeUp(turnEndTime);
+		return;
+	}
+
+	//	Still thinking, check again next update
+	if(!thinking.IsReady())
+		return;
+
+	const int chosenMove = thinking.Get();
+
+	//	Perform move
+	gameField.MakeMove(chosenMove, GetFactionGlyph());
+
+	//	Conclude turn
+	Conclude();
+}
+
+void CPUTurnController::TurnClosingOperations()
+{
+	//	Turns close early when the game starts over, the move isn't wanted anymore
+	thinking.Cancel();
+}
+
+int CPUTurnController::FindMove(const atomic<bool> & cancelled, bool virtualTime)
+{
+	/*
+	 * Hard difficulty plays perfectly, other difficulties rely
+	 * on heuristics to make mistakes. Perfect play is only known
+	 * for the classic board and for the boards of the tablebase,
+	 * on other boards Hard difficulty looks for a forced win
+	 * through threats first, it goes far deeper than a full
+	 * search in a fraction of the time, and searches as deep as
+	 * its time budget allows only when there's none.
+	 */
+	lastSearch = DeepeningResult();
+	lastThreatSearch = ThreatResult();
+	if(!playPerfectMove)
+		return FindHeuristicMove();
+	if(gameField.GetBoard().IsClassic())
+		return FindPerfectMove();
+	if(tablebase && tablebase->Covers(gameField.GetBoard().GetRules()))
+		return FindTablebaseMove();
+
+	lastThreatSearch = threatSearcher.Search(gameField.GetBoard(), GetFactionGlyph(), &cancelled, virtualTime);
+	if(lastThreatSearch.IsWin())
+		return lastThreatSearch.winningMove;
+
+	lastSearch = searcher.Search(gameField.GetBoard(), GetFactionGlyph(), &cancelled, virtualTime);
+	assert(lastSearch.bestMove > -1);	//	Shouldn't ever happen, turns are not given on a finished game
+	return lastSearch.bestMove;
+}
+
+int CPUTurnController::FindHeuristicMove() const
+{
+	/*
 	 * This one is a simplicistic AI algorith, based
 	 * on a concept of priorities:
 	 * - Can the opponent win with a move? Block it!
@@ -89,15 +194,13 @@ void CPUTurnController::TurnUpdateOperations()
 	 * - None of those? Make a move that enhances my
 	 *		current position
 	 * Actually not so far from a minimax iplementation
-	 * but this is a bit more dumb (no recursion, no dpth).
+	 * but this is a bit more dumb (no recursion, no dpth),
+	 * which is exactly what we want from the easier
+	 * difficulties.
 	 */
 
-	//	Wait until the turn ends (faking the AI's speculations)
-	if(SDL_GetTicks64() < turnEndTime)
-		return;
-
 	//	Storing opponent's glyph to evaluate its best move and find a defensive move
-	const FactionGlyph opponentFactionGlyph = GetFactionGlyph() == FG_Cross ? FG_Circle : FG_Cross;
+	const FactionGlyph opponentFactionGlyph = GetOpponentGlyph(GetFactionGlyph());
 
 	//	Find a defensive move
 	bool opponentConclusiveMove;	//	Actually not used...
@@ -111,7 +214,7 @@ void CPUTurnController::TurnUpdateOperations()
 	const int fallbackMove = gameField.GetRandomEmptyCell();
 
 	//	Make decision based on difficulty
-	int chosenMove;
+	int chosenMove = -1;
 	if(
 		defensiveMove > -1 &&
 		Random::GetChance(defenseChance) &&
@@ -130,9 +233,63 @@ void CPUTurnController::TurnUpdateOperations()
 		assert(false);	//	Shouldn't ever happen, unless there's at least one empty cell
 	}
 
-	//	Perform move
-	gameField.MakeMove(chosenMove / 3, chosenMove % 3, GetFactionGlyph());
+	return chosenMove;
+}
 
-	//	Conclude turn
-	Conclude();
+int CPUTurnController::FindPerfectMove() const
+{
+	/*
+	 * The whole game tree has been solved at compile time,
+	 * so the best moves for the current board are just a
+	 * lookup away. Picking one of them at random keeps the
+	 * games varied while never giving away a better result.
+	 */
+	const CellsMask bestMoves = PerfectPlayTable::Lookup(gameField.GetBoard().ToBitboard()).bestMoves;
+	assert(bestMoves);	//	Shouldn't ever happen, turns are not given on a finished game
+
+	const int bestMovesCount = Bitboard::CountCells(bestMoves);
+	if(bestMovesCount < 2)
+		return Bitboard::LowestCell(bestMoves);
+
+	return Bitboard::GetNthCell(bestMoves, Random::Range(0, bestMovesCount));
+}
+
+int CPUTurnController::FindTablebaseMove() const
+{
+	/*
+	 * The tablebase knows the value of every position a move
+	 * leads to, seen from the opponent: the best move leaves it
+	 * the worst one. Values don't tell how soon a game is won,
+	 * so a winning move is played as soon as there's one, rather
+	 * than a move merely keeping the win, and the others are
+	 * picked at random among the best ones, like perfect moves.
+	 */
+	const Board & board = gameField.GetBoard();
+	TablebaseMask crossMask;
+	TablebaseMask circleMask;
+	Tablebase::GetMasks(board, crossMask, circleMask);
+
+	TablebaseValue bestValue = TV_Loss;
+	vector<int> bestMoves;
+	for(const int cell : board.GetEmptyCells())
+	{
+		if(board.IsWinningMove(cell, GetFactionGlyph()))
+			return cell;
+
+		const TablebaseMask cellBit = (TablebaseMask)1 << cell;
+		const TablebaseValue opponentValue = GetFactionGlyph() == FG_Cross ?
+			tablebase->Lookup(crossMask | cellBit, circleMask) :
+			tablebase->Lookup(crossMask, circleMask | cellBit);
+		const TablebaseValue value = (TablebaseValue)(TV_Win - opponentValue);
+		if(value > bestValue)
+		{
+			bestValue = value;
+			bestMoves.clear();
+		}
+		if(value == bestValue)
+			bestMoves.push_back(cell);
+	}
+	assert(!bestMoves.empty());	//	Shouldn't ever happen, turns are not given on a finished game
+
+	return bestMoves[Random::Range(0, (int)bestMoves.size())];
 }
@@ -4,9 +4,17 @@
 #include <SDL_timer.h>
 #pragma endregion
 
+#pragma region Engine Includes
+#include "JobSystem.h"
+#include "RandomEngine.h"
+#pragma endregion
+
 #pragma region Game Includes
 #include "ATurnController.h"
 #include "Field.h"
+#include "IterativeDeepeningSearcher.h"
+#include "ThreatSpaceSearcher.h"
+#include "Tablebase.h"
 #pragma endregion
 
 /*
@@ -30,11 +38,31 @@ enum class Difficulty
  * game. It implements ATurnController, which in turn
  * implements ITurnsReceiver, so its lifecycle is entirely
  * scheduled by the TurnsScheduler.
- * All this class does is simulating a "thinking..." delay
- * and then calculates a move and performs it on the field.
+ * All this class does is calculating a move and performing
+ * it on the field.
+ * The move is calculated in the background, started as soon
+ * as the turn is updated, so however long it takes frames go on,
+ * and it's made as soon as it's ready. Easy and Medium find their
+ * moves at once, so when someone is watching (see
+ * SetThinkingDelay) they also wait for a "thinking..." delay:
+ * the delay is only the least the turn lasts. It's never waited
+ * on a virtual clock, and it's drawn from an engine of its own,
+ * so it doesn't change the moves. Starting over in the meantime
+ * calls the calculation off.
  * To calculate the move, takes into account different
  * possibilities and makes a choice, ,that can be better or
  * worse,based on the difficulty.
+ * On Hard difficulty the heuristics are replaced by a lookup
+ * in the perfect play table, so the CPU plays perfectly (on
+ * the classic 3x3 board, the only one the table covers), and
+ * on other boards by a lookup in the tablebase, when one for
+ * the board is given (see the tablebase tool), or else by a
+ * threat-space search for a forced win, and when there's none
+ * by an iterative deepening search, which answers within the
+ * time budget of the settings in place when the controller is
+ * created and keeps how deep it got for whoever wants to know. On a virtual clock the
+ * budgets of both searches are counted in nodes, so the same
+ * seed plays the same moves whatever the machine.
  * There's no need to make checks if this is the correct
  * moment to take actions, because the turns scheduler
  * already sends messages only to the relevant receiver
@@ -47,26 +75,55 @@ public:
 protected:
 private:
 	Difficulty difficulty;
+	static DeepeningSettings defaultSettings;
+	static ThreatSettings defaultThreatSettings;
+	static const Tablebase * tablebase;
+	static bool thinkingDelay;
 	Field & gameField;
-	Uint64 turnEndTime;
+	RandomEngine delayEngine;
+	Uint64 turnEndTime = 0;
 	float defenseChance;
 	float offenseChance;
 	bool prioritizeWinningMove;
+	bool playPerfectMove;
+	IterativeDeepeningSearcher searcher;
+	ThreatSpaceSearcher threatSearcher;
+	DeepeningResult lastSearch;
+	ThreatResult lastThreatSearch;
+	AsyncTask<int> thinking;	//	Declared after the searcher, so it's called off before the searcher goes away
 	// Constructors
 public:
-	CPUTurnController(Difficulty initialDifficulty, Field & gameField, FactionGlyph factionGlyph);
+	CPUTurnController(Difficulty initialDifficulty, Field & gameField, FactionGlyph factionGlyph, const DeepeningSettings & settings = defaultSettings);
 protected:
 private:
 	// Methods
 public:
 	void SetDifficulty(Difficulty newDifficulty);
+	//	Telemetry of the last move searched (none made with heuristics, perfect play or a forced win through threats), only while not thinking
+	__inline const DeepeningResult & GetLastSearch() const { return lastSearch; }
+	//	Telemetry of the last threat search (none made with heuristics or perfect play), only while not thinking
+	__inline const ThreatResult & GetLastThreatSearch() const { return lastThreatSearch; }
+
+	//	Settings for the controllers created from now on
+	__inline static void SetDefaultSettings(const DeepeningSettings & settings) { defaultSettings = settings; }
+	__inline static const DeepeningSettings & GetDefaultSettings() { return defaultSettings; }
+	__inline static void SetDefaultThreatSettings(const ThreatSettings & settings) { defaultThreatSettings = settings; }
+	__inline static const ThreatSettings & GetDefaultThreatSettings() { return defaultThreatSettings; }
+	//	Shared by all controllers, nullptr for none, it must outlive them
+	__inline static void SetTablebase(const Tablebase * newTablebase) { tablebase = newTablebase; }
+	//	Whether Easy and Medium fake some thinking on real time, for the controllers' turns from now on (off by default)
+	__inline static void SetThinkingDelay(bool delay) { thinkingDelay = delay; }
 protected:
 private:
-	static Uint32 GetTurnDuration(Difficulty difficulty);
+	Uint32 GetTurnDuration();
+	int FindHeuristicMove() const;
+	int FindPerfectMove() const;
+	int FindTablebaseMove() const;
+	int FindMove(const atomic<bool> & cancelled, bool virtualTime);
 
 	//	ATurnController implementation
 	void TurnOpeningOperations();
 	void TurnUpdateOperations();
-	void TurnClosingOperations() { }
+	void TurnClosingOperations();
 };
 
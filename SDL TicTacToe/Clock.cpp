@@ -0,0 +1,40 @@
+#include "Clock.h"
+
+#pragma region C++ Includes
+#include <cassert>
+#pragma endregion
+
+void Clock::UseVirtualClock(bool useVirtualClock)
+{
+	//	Start the virtual clock from the real time, so switching clock never goes back in time
+	if(useVirtualClock && !virtualClock)
+		virtualTicks = SDL_GetTicks64();
+
+	virtualClock = useVirtualClock;
+}
+
+void Clock::AdvanceVirtualClock(Uint64 millis)
+{
+	assert(virtualClock);	//	Real time can't be moved
+
+	virtualTicks += millis;
+}
+
+void Clock::RequestWakeUp(Uint64 ticks)
+{
+	//	Only the earliest request matters, later ones will be requested again when that one is served
+	if(ticks < nextWakeUpTicks)
+		nextWakeUpTicks = ticks;
+}
+
+void Clock::AdvanceToNextWakeUp()
+{
+	if(!HasWakeUpRequest())
+		return;
+
+	//	Jump to the requested time (if still in the future) and serve the request
+	if(virtualClock && nextWakeUpTicks > virtualTicks)
+		virtualTicks = nextWakeUpTicks;
+
+	nextWakeUpTicks = NoWakeUp;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#pragma region SDL Includes
+#include <SDL_timer.h>
+#pragma endregion
+
+/*
+ * Centralized (singleton) time management class.
+ * Anybody who needs to wait for something should read the
+ * time from here instead of asking SDL directly, so the clock
+ * can be swapped with a virtual one: a virtual clock doesn't
+ * flow by itself, it's moved forward by the main loop, which
+ * is what makes it possible to run games as fast as the CPU
+ * allows (e.g. headless simulations) without touching the
+ * logic that waits.
+ *
+ * Who waits for a given time can also request a wake-up at
+ * that time, so the main loop knows when something is going
+ * to happen and, with a virtual clock, can jump straight there.
+ *
+ * There's one clock per thread: threads running their own games
+ * (e.g. batch self-play) move their own virtual time.
+ */
+class Clock
+{
+	// Fields
+public:
+	static const Uint64 NoWakeUp = ~0ull;
+protected:
+private:
+	bool virtualClock = false;
+	Uint64 virtualTicks = 0;
+	Uint64 nextWakeUpTicks = NoWakeUp;
+	// Constructors
+public:
+	// Delete copy constructor and assignment operator (singleton protection)
+	Clock(const Clock &) = delete;
+	Clock & operator=(const Clock &) = delete;
+protected:
+private:
+	Clock() { }
+	// Methods
+public:
+	static Clock & Get()
+	{
+		//	Singleton implementation (one instance per thread)
+		thread_local Clock instance;
+		return instance;
+	}
+
+	//	Current time in milliseconds, either real or virtual
+	__inline Uint64 GetTicks() const { return virtualClock ? virtualTicks : SDL_GetTicks64(); }
+
+	void UseVirtualClock(bool useVirtualClock);
+	__inline bool IsVirtualClock() const { return virtualClock; }
+	void AdvanceVirtualClock(Uint64 millis);
+
+	void RequestWakeUp(Uint64 ticks);
+	__inline bool HasWakeUpRequest() const { return nextWakeUpTicks != NoWakeUp; }
+	__inline Uint64 GetNextWakeUp() const { return nextWakeUpTicks; }
+	void AdvanceToNextWakeUp();
+protected:
+private:
+};
@@ -0,0 +1,150 @@
+#include "CommandLine.h"
+
+#pragma region C++ Includes
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Longest run length a board gets when only its size is given
+#define DEFAULT_MAX_RUN_LENGTH 5
+#pragma endregion
+
+using namespace std;
+
+const char * CommandLine::FindArgValue(int argc, char * argv[], const char * argCheck)
+{
+	//	Iterate command line arguments and look for an argument matching the argCheck parameter, return the following one
+	for(int a = 0; a < argc - 1; a++)
+		if(strcmp(argv[a], argCheck) == 0)
+			return argv[a + 1];
+
+	return nullptr;
+}
+
+const char * CommandLine::FindPrefixedArgValue(int argc, char * argv[], const char * argPrefix)
+{
+	//	Iterate command line arguments and look for an argument starting with argPrefix, return what follows
+	const size_t prefixLength = strlen(argPrefix);
+	for(int a = 0; a < argc; a++)
+		if(strncmp(argv[a], argPrefix, prefixLength) == 0)
+			return argv[a] + prefixLength;
+
+	return nullptr;
+}
+
+bool CommandLine::HasFlag(int argc, char * argv[], const char * argCheck)
+{
+	//	Iterate command line arguments and look for an argument matching the argCheck parameter
+	for(int a = 0; a < argc; a++)
+		if(strcmp(argv[a], argCheck) == 0)
+			return true;
+
+	return false;
+}
+
+void CommandLine::OverrideCount(int argc, char * argv[], const char * argCheck, int & count, int minCount)
+{
+	/*
+	 * Iterate command line arguments and look for an argument
+	 * matching the argCheck parameter, followed by a number not
+	 * below minCount.
+	 * If found, override the count.
+	 */
+	for(int a = 0; a < argc; a++)
+		if(
+			strcmp(argv[a], argCheck) == 0 &&
+			a < argc - 1
+		)
+		{
+			//	The whole value has to be a number, so that "abc" isn't taken for a zero
+			char * parseEnd = nullptr;
+			const long parsedCount = strtol(argv[a + 1], &parseEnd, 10);
+			if(parseEnd != argv[a + 1] && *parseEnd == '\0' && parsedCount >= minCount && parsedCount <= INT_MAX)
+				count = (int)parsedCount;
+			else
+				cout << "Ignoring invalid count: " << argv[a + 1] << endl;
+		}
+}
+
+void CommandLine::OverrideFactor(int argc, char * argv[], const char * argCheck, float & factor)
+{
+	/*
+	 * Iterate command line arguments and look for an argument
+	 * matching the argCheck parameter, followed by a positive
+	 * decimal number.
+	 * If found, override the factor.
+	 */
+	for(int a = 0; a < argc; a++)
+		if(
+			strcmp(argv[a], argCheck) == 0 &&
+			a < argc - 1
+		)
+		{
+			const float parsedFactor = (float)atof(argv[a + 1]);
+			if(parsedFactor > 0.0f)
+				factor = parsedFactor;
+			else
+				cout << "Ignoring invalid factor: " << argv[a + 1] << endl;
+		}
+}
+
+void CommandLine::OverrideSeed(int argc, char * argv[], const char * argCheck, uint64_t & seed)
+{
+	/*
+	 * Iterate command line arguments and look for an argument
+	 * matching the argCheck parameter, followed by a number.
+	 * If found, override the seed.
+	 */
+	for(int a = 0; a < argc; a++)
+		if(
+			strcmp(argv[a], argCheck) == 0 &&
+			a < argc - 1
+		)
+		{
+			char * parseEnd = nullptr;
+			const unsigned long long parsedSeed = strtoull(argv[a + 1], &parseEnd, 10);
+			if(parseEnd != argv[a + 1] && *parseEnd == '\0')
+				seed = parsedSeed;
+			else
+				cout << "Ignoring invalid seed: " << argv[a + 1] << endl;
+		}
+}
+
+void CommandLine::OverrideBoardRules(int argc, char * argv[], const char * argCheck, BoardRules & boardRules, int maxCellsCount)
+{
+	/*
+	 * Iterate command line arguments and look for an argument
+	 * matching the argCheck parameter, followed by the board
+	 * size and, optionally, the run length needed to win.
+	 * If found and valid, override the board rules.
+	 */
+	for(int a = 0; a < argc; a++)
+		if(
+			strcmp(argv[a], argCheck) == 0 &&
+			a < argc - 1
+		)
+		{
+			BoardRules parsedRules;
+			const int parsedValues = sscanf(argv[a + 1], "%dx%dx%d", &parsedRules.columns, &parsedRules.rows, &parsedRules.runLength);
+			if(parsedValues < 2)
+				continue;
+			if(parsedValues < 3)
+				parsedRules.runLength = min(DEFAULT_MAX_RUN_LENGTH, min(parsedRules.columns, parsedRules.rows));
+
+			if(
+				parsedRules.columns < 1 || parsedRules.rows < 1 ||
+				parsedRules.columns > maxCellsCount / parsedRules.rows ||
+				parsedRules.runLength < 1 || parsedRules.runLength > max(parsedRules.columns, parsedRules.rows)
+			)
+			{
+				cout << "Ignoring invalid board rules: " << argv[a + 1] << endl;
+				continue;
+			}
+
+			boardRules = parsedRules;
+		}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <cstdint>
+#include <climits>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#pragma endregion
+
+/*
+ * Utility class for reading command line arguments, shared by
+ * the game and the tools so that they all take the same values
+ * the same way.
+ *
+ * Arguments are looked up by key, the value being the argument
+ * that follows it (e.g. "--seed 1234"); when a key is passed more
+ * than once, the last valid value wins. Invalid values are
+ * reported and ignored, leaving what was there before.
+ *
+ * Boards are given as columns x rows, optionally followed by the
+ * run length needed to win (e.g. "7x7x4"); without it, the run
+ * length is the smallest side of the board, up to five (so 3x3
+ * plays Tic-Tac-Toe and 15x15 plays Gomoku).
+ */
+class CommandLine
+{
+public:
+	//	Value following the given key, if any
+	static const char * FindArgValue(int argc, char * argv[], const char * argCheck);
+	//	Rest of the first argument starting with the given prefix (e.g. "--key="), if any
+	static const char * FindPrefixedArgValue(int argc, char * argv[], const char * argPrefix);
+	//	Whether the given key was passed at all
+	static bool HasFlag(int argc, char * argv[], const char * argCheck);
+
+	//	Override the count if the key is followed by a number, at least minCount (e.g. 0 where zero means none or no limit)
+	static void OverrideCount(int argc, char * argv[], const char * argCheck, int & count, int minCount = 1);
+	//	Override the factor if the key is followed by a positive decimal number
+	static void OverrideFactor(int argc, char * argv[], const char * argCheck, float & factor);
+	//	Override the seed if the key is followed by a number
+	static void OverrideSeed(int argc, char * argv[], const char * argCheck, uint64_t & seed);
+	//	Override the rules if the key is followed by a valid board, of up to maxCellsCount cells
+	static void OverrideBoardRules(int argc, char * argv[], const char * argCheck, BoardRules & boardRules, int maxCellsCount = INT_MAX);
+
+	//	Same as the overrides, starting from a default value and returning the result
+	__inline static int ParseCount(int argc, char * argv[], const char * argCheck, int defaultCount, int minCount = 1) { int count = defaultCount; OverrideCount(argc, argv, argCheck, count, minCount); return count; }
+	__inline static uint64_t ParseSeed(int argc, char * argv[], const char * argCheck, uint64_t defaultSeed) { uint64_t seed = defaultSeed; OverrideSeed(argc, argv, argCheck, seed); return seed; }
+	__inline static BoardRules ParseBoardRules(int argc, char * argv[], const char * argCheck, const BoardRules & defaultRules, int maxCellsCount = INT_MAX) { BoardRules boardRules = defaultRules; OverrideBoardRules(argc, argv, argCheck, boardRules, maxCellsCount); return boardRules; }
+};
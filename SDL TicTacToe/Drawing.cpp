@@ -1,9 +1,13 @@
 #include "Drawing.h"
 
 #pragma region C++ Includes
-#include <vector>
+#include <cmath>
+#include <algorithm>
 #pragma endregion
 
+#pragma region Engine Includes
+#include "GeometryBatch.h"
+#pragma endregion
 
 using namespace std;
 
@@ -16,13 +20,69 @@ using namespace std;
 
 //	Geometry
 #define CIRCLE_POINTS 32
+#define PIXEL_CENTER 0.5f	//	Integer coordinates address pixels, strokes run through their centers
+#define MIN_STROKE_WIDTH 1.0f
+#define GLYPH_STROKE_RATIO 0.06f	//	Of the glyph's radius
+#define CHAR_STROKE_RATIO 0.04f	//	Of the character's shorter side
+#define CHAR_MAX_POINTS 6
 
 //	Trygonometry
-#define PI 3.1415293f
+#define PI 3.14159265f
 #define PI2 (2 * PI)
 #define HPI (PI / 2)
 #pragma endregion
 
+/*
+ * Nothing is drawn right away: shapes are collected into a
+ * single batch and drawn all together, in one call, when the
+ * frame is done (see FlushDrawing).
+ * The batch belongs to a renderer, so drawing for another one
+ * (e.g. a render target texture has its own renderer state)
+ * draws what's pending first.
+ */
+
+static GeometryBatch batch;
+static SDL_Renderer * batchRenderer = nullptr;
+
+static GeometryBatch & GetBatch(SDL_Renderer * r)
+{
+	if(r != batchRenderer)
+	{
+		if(batchRenderer)
+			batch.Flush(batchRenderer);
+		batchRenderer = r;
+	}
+	return batch;
+}
+
+void FlushDrawing(SDL_Renderer * r)
+{
+	GetBatch(r).Flush(r);
+}
+
+/*
+ * Circles of any radius are the same unit circle, scaled:
+ * its points are calculated once, on startup, and then
+ * every circle just reads them.
+ */
+
+struct UnitCircle
+{
+	SDL_FPoint points[CIRCLE_POINTS];
+	UnitCircle()
+	{
+		const float angleStep = PI2 / CIRCLE_POINTS;
+		for(int i = 0; i < CIRCLE_POINTS; i++)
+			points[i] = { cos(angleStep * i), sin(angleStep * i) };
+	}
+};
+static const UnitCircle unitCircle;
+
+static float GetGlyphStrokeWidth(int radius)
+{
+	return max(MIN_STROKE_WIDTH, radius * GLYPH_STROKE_RATIO);
+}
+
 /*
  * Cross and Circle glyphs are drawn in a really simple way,
  * line by line.
@@ -32,22 +92,17 @@ using namespace std;
 
 void DrawCross(SDL_Renderer * r, int x, int y, int radius)
 {
-	SDL_SetRenderDrawColor(r, COL_CROSS);
-	SDL_RenderDrawLine(r, x - radius, y - radius, x + radius, y + radius);
-	SDL_RenderDrawLine(r, x + radius, y - radius, x - radius, y + radius);
+	const float centerX = x + PIXEL_CENTER;
+	const float centerY = y + PIXEL_CENTER;
+	const float strokeWidth = GetGlyphStrokeWidth(radius);
+	GeometryBatch & geometry = GetBatch(r);
+	geometry.AddStroke(centerX - radius, centerY - radius, centerX + radius, centerY + radius, strokeWidth, {COL_CROSS});
+	geometry.AddStroke(centerX + radius, centerY - radius, centerX - radius, centerY + radius, strokeWidth, {COL_CROSS});
 }
 
 void DrawCircle(SDL_Renderer * r, int x, int y, int radius)
 {
-	SDL_SetRenderDrawColor(r, COL_CIRCLE);
-	float angleStep = PI2 / CIRCLE_POINTS;
-	vector<SDL_Point> points;
-	for(int i = 0; i <= CIRCLE_POINTS; i++)
-	{
-		float angle = angleStep * i;
-		points.push_back({ x + (int)(cos(angle) * radius), y + (int)(sin(angle) * radius) });
-	}
-	SDL_RenderDrawLines(r, points.data(), CIRCLE_POINTS + 1);
+	GetBatch(r).AddRing(x + PIXEL_CENTER, y + PIXEL_CENTER, (float)radius, GetGlyphStrokeWidth(radius), unitCircle.points, CIRCLE_POINTS, {COL_CIRCLE});
 }
 
 /*
@@ -89,69 +144,106 @@ void DrawChar(SDL_Renderer * r, const SDL_Rect * area, const char chr, int paddi
 		area->h - padding * 2
 	};
 
-	//	Prepare a set of points to be drawn as lines
-	vector<SDL_Point> points;
+	//	Prepare a set of points to be drawn as lines (on the stack, no character needs many)
+	SDL_Point points[CHAR_MAX_POINTS];
+	int pointsCount = 0;
 
 	//	Fill points with vertices according to the character requested to draw
 	switch(chr)
 	{
 		case 'a':
 		case 'A':
-			points.push_back({bounds.x, bounds.y + bounds.h});
-			points.push_back({bounds.x, bounds.y});
-			points.push_back({bounds.x + bounds.w, bounds.y});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h / 2});
-			points.push_back({bounds.x, bounds.y + bounds.h / 2});
+			points[pointsCount++] = {bounds.x, bounds.y + bounds.h};
+			points[pointsCount++] = {bounds.x, bounds.y};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h / 2};
+			points[pointsCount++] = {bounds.x, bounds.y + bounds.h / 2};
 			break;
 		case 'd':
 		case 'D':
-			points.push_back({bounds.x, bounds.y + bounds.h});
-			points.push_back({bounds.x, bounds.y});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h / 2});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h});
-			points.push_back(points[0]);	//	Close loop
+			points[pointsCount++] = {bounds.x, bounds.y + bounds.h};
+			points[pointsCount++] = {bounds.x, bounds.y};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h / 2};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h};
+			points[pointsCount++] = points[0];	//	Close loop
 			break;
 		case 'i':
 		case 'I':
-			points.push_back({bounds.x + bounds.w / 2, bounds.y});
-			points.push_back({bounds.x + bounds.w / 2, bounds.y + bounds.h});
+			points[pointsCount++] = {bounds.x + bounds.w / 2, bounds.y};
+			points[pointsCount++] = {bounds.x + bounds.w / 2, bounds.y + bounds.h};
 			break;
 		case 'n':
 		case 'N':
-			points.push_back({bounds.x, bounds.y + bounds.h});
-			points.push_back({bounds.x, bounds.y});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h});
-			points.push_back({bounds.x + bounds.w, bounds.y});
+			points[pointsCount++] = {bounds.x, bounds.y + bounds.h};
+			points[pointsCount++] = {bounds.x, bounds.y};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y};
 			break;
 		case 'r':
 		case 'R':
-			points.push_back({bounds.x, bounds.y + bounds.h});
-			points.push_back({bounds.x, bounds.y});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h / 3});
-			points.push_back({bounds.x, bounds.y + (bounds.h / 3) * 2});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h});
+			points[pointsCount++] = {bounds.x, bounds.y + bounds.h};
+			points[pointsCount++] = {bounds.x, bounds.y};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h / 3};
+			points[pointsCount++] = {bounds.x, bounds.y + (bounds.h / 3) * 2};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h};
 			break;
 		case 's':
 		case 'S':
-			points.push_back({bounds.x + bounds.w, bounds.y});
-			points.push_back({bounds.x, bounds.y});
-			points.push_back({bounds.x, bounds.y + bounds.h / 2});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h / 2});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h});
-			points.push_back({bounds.x, bounds.y + bounds.h});
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y};
+			points[pointsCount++] = {bounds.x, bounds.y};
+			points[pointsCount++] = {bounds.x, bounds.y + bounds.h / 2};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h / 2};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h};
+			points[pointsCount++] = {bounds.x, bounds.y + bounds.h};
 			break;
 		case 'w':
 		case 'W':
-			points.push_back({bounds.x, bounds.y});
-			points.push_back({bounds.x, bounds.y + bounds.h});
-			points.push_back({bounds.x + bounds.w / 2, bounds.y + bounds.h / 2});
-			points.push_back({bounds.x + bounds.w, bounds.y + bounds.h});
-			points.push_back({bounds.x + bounds.w, bounds.y});
+			points[pointsCount++] = {bounds.x, bounds.y};
+			points[pointsCount++] = {bounds.x, bounds.y + bounds.h};
+			points[pointsCount++] = {bounds.x + bounds.w / 2, bounds.y + bounds.h / 2};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y + bounds.h};
+			points[pointsCount++] = {bounds.x + bounds.w, bounds.y};
 			break;
 	}
 
 	//	Render the lines between the pairs of vertices
-	SDL_SetRenderDrawColor(r, COL_CHAR);
-	SDL_RenderDrawLines(r, points.data(), (int)points.size());
+	const float strokeWidth = max(MIN_STROKE_WIDTH, min(bounds.w, bounds.h) * CHAR_STROKE_RATIO);
+	GeometryBatch & geometry = GetBatch(r);
+	for(int i = 1; i < pointsCount; i++)
+		geometry.AddStroke(
+			points[i - 1].x + PIXEL_CENTER, points[i - 1].y + PIXEL_CENTER,
+			points[i].x + PIXEL_CENTER, points[i].y + PIXEL_CENTER,
+			strokeWidth,
+			{COL_CHAR}
+		);
+}
+
+/*
+ * Plain shapes for debug overlays, such as the frame time
+ * graph or the board grid: no style here, just filled rects,
+ * outlines and lines of the given color.
+ */
+
+void DrawBar(SDL_Renderer * r, const SDL_Rect * area, SDL_Color color)
+{
+	GetBatch(r).AddRect(*area, color);
+}
+
+void DrawOutline(SDL_Renderer * r, const SDL_Rect * area, SDL_Color color)
+{
+	if(area->w <= 0 || area->h <= 0)
+		return;
+
+	//	Same pixels as SDL_RenderDrawRect: the outermost ones within the area
+	GeometryBatch & geometry = GetBatch(r);
+	geometry.AddRect({area->x, area->y, area->w, 1}, color);
+	geometry.AddRect({area->x, area->y + area->h - 1, area->w, 1}, color);
+	geometry.AddRect({area->x, area->y + 1, 1, area->h - 2}, color);
+	geometry.AddRect({area->x + area->w - 1, area->y + 1, 1, area->h - 2}, color);
+}
+
+void DrawLine(SDL_Renderer * r, int x1, int y1, int x2, int y2, SDL_Color color)
+{
+	GetBatch(r).AddStroke(x1 + PIXEL_CENTER, y1 + PIXEL_CENTER, x2 + PIXEL_CENTER, y2 + PIXEL_CENTER, MIN_STROKE_WIDTH, color);
 }
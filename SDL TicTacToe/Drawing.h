@@ -8,6 +8,16 @@
 #include "Tokens.h"
 #pragma endregion
 
+/*
+ * Drawing functions don't draw right away: they all fill the
+ * same batch of triangles, drawn in a single call when the
+ * frame is done, or when switching to another renderer. Call
+ * this one before presenting the frame, or before changing
+ * the render target, to draw everything pending.
+ */
+
+void FlushDrawing(SDL_Renderer * r);
+
 /*
  * Cross and Circle glyphs are drawn in a really simple way,
  * line by line.
@@ -36,3 +46,15 @@ void DrawGlyph(SDL_Renderer * r, FactionGlyph glyph, int x, int y, int radius);
  */
 
 void DrawChar(SDL_Renderer * r, const SDL_Rect * area, const char chr, int padding = 10);
+
+/*
+ * Plain shapes for debug overlays, such as the frame time
+ * graph or the board grid: no style here, just filled rects,
+ * outlines and lines of the given color.
+ */
+
+void DrawBar(SDL_Renderer * r, const SDL_Rect * area, SDL_Color color);
+
+void DrawOutline(SDL_Renderer * r, const SDL_Rect * area, SDL_Color color);
+
+void DrawLine(SDL_Renderer * r, int x1, int y1, int x2, int y2, SDL_Color color);
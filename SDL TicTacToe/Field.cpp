@@ -17,69 +17,48 @@ using namespace std;
 
 #pragma region Constant Parameters
 #define COL_FIELD 200, 200, 200, 255
+#define COL_BOARD_CLEAR 0, 0, 0, 0
 #pragma endregion
 
-/*
- * Solutions to the Tic-Tac-Toe game are few and fixed
- * so it's a good idea to store them statically so
- * they're available to any function which may need
- * them and are not duplicated in case more than one
- * field is instantiated.
- */
-
-int Field::winCombos[8][3] =
-	{
-		{0, 1, 2},
-		{3, 4, 5},
-		{6, 7, 8},
-		{0, 3, 6},
-		{1, 4, 7},
-		{2, 5, 8},
-		{0, 4, 8},
-		{2, 4, 6}
-	};
-
-Field::Field(const SDL_Rect & area) :
-	area(area)
+Field::Field(const SDL_Rect & area, const BoardRules & rules) :
+	area(area),
+	board(rules)
 {
 	//	Make sure to initialize the class in a consistent state
 	CalculateFieldMetrics();
 	Reset();
 }
 
+Field::~Field()
+{
+	ReleaseBoardTexture();
+}
+
 void Field::Reset()
 {
-	//	Fill the field with empty cells
-	fill(begin(cells), end(cells), FG_None);
-	
-	/*
-	 * Instead of iterating through the field, checking
-	 * empty cells and adding them to a vector every time
-	 * anybody needs to know what are empty cells, we
-	 * preferred storing a vector of empty cells and
-	 * modifying it any time the field changes.
-	 * 
-	 * In this case we're clearing any possible value
-	 * previously stored in the vector and adding back
-	 * all cells, since as we restart the game the field
-	 * gets cleared and all cells are empty.
-	 * 
-	 * See Field::MakeMove() for more details
-	 */
+	board.Reset();
+	boardDirty = true;
 
-	//	Empty cells are all cells
-	emptyCells.clear();
-	for(int c = 0; c < sizeof(cells) / sizeof(cells[0]); c++)
-		emptyCells.push_back(c);
+	//	Whatever happened on the board, that game is over (e.g. abandoned halfway)
+	if(moveLog)
+		moveLog->EndGame();
 }
 
 bool Field::TestCell(SDL_Point point, int & row, int & col) const
 {
-	//	Iterate cells to check if point is in any of them (using reference variable so they're read at return)
-	for(row = 0; row < 3; row++)
-		for(col = 0; col < 3; col++)
-			if(SDL_PointInRect(&point, &cellsAreas[row][col]))
-				return true;
+	/*
+	 * Cells are all the same size and laid out in a grid, so
+	 * there's no need to test them one by one: the cell under
+	 * the point is found by dividing its offset from the
+	 * field's corner by the size of a cell.
+	 */
+	if(cellSize > 0 && SDL_PointInRect(&point, &fieldArea))
+	{
+		row = (point.y - fieldArea.y) / cellSize;
+		col = (point.x - fieldArea.x) / cellSize;
+		if(board.IsInside(row, col))
+			return true;
+	}
 
 	//	Point not in any cell, unset coords and reurn failure
 	row = -1;
@@ -89,6 +68,8 @@ bool Field::TestCell(SDL_Point point, int & row, int & col) const
 
 int Field::GetRandomEmptyCell() const
 {
+	const vector<int> & emptyCells = board.GetEmptyCells();
+
 	if(emptyCells.size() < 1)
 		return -1;
 	
@@ -100,49 +81,61 @@ int Field::GetRandomEmptyCell() const
 
 int Field::GetMoveScore(FactionGlyph glyph, int row, int col) const
 {
-	//	Convert from matrix to linear index
-	int cellIndex = row * 3 + col;
+	/*
+	 * Every run of cells through this cell, long enough to
+	 * win the game, is a combo this move contributes to.
+	 * Each combo is scored by its other cells: empty cells
+	 * give 1, own cells give 2 and opponent's cells take 3,
+	 * on top of a base score that makes a combo made only of
+	 * opponent's and empty cells negative.
+	 * The move is worth as much as its best combo.
+	 */
+	const int runLength = board.GetRunLength();
+	const int baseScore = -(2 * runLength - 1);
 
-	if(cells[cellIndex] != FG_None)
-		return -5;
+	if(GetCell(row, col) != FG_None)
+		return baseScore;
 
 	//	Init best score to a neutral value
-	int bestComboScore = -5;
+	int bestComboScore = baseScore;
 
-	for(auto winCombo : winCombos)
+	for(int direction = 0; direction < Board::DirectionsCount; direction++)
 	{
-		int comboIndex = -1;
-		for(int c = 0; c < 3; c++)
+		const int rowStep = Board::Directions[direction][0];
+		const int colStep = Board::Directions[direction][1];
+
+		//	Slide a combo along the line, so that it always includes the cell
+		for(int offset = -(runLength - 1); offset <= 0; offset++)
 		{
-			//	Find placement of cell in combo
-			if(winCombo[c] == cellIndex)
+			const int firstRow = row + offset * rowStep;
+			const int firstCol = col + offset * colStep;
+			const int lastRow = firstRow + (runLength - 1) * rowStep;
+			const int lastCol = firstCol + (runLength - 1) * colStep;
+
+			//	Combo doesn't fit the board? Skip
+			if(!board.IsInside(firstRow, firstCol) || !board.IsInside(lastRow, lastCol))
+				continue;
+
+			//	Check if winning combo
+			int score = baseScore;
+			for(int c = 0; c < runLength; c++)
 			{
-				comboIndex = c;
-				break;
+				if(c == -offset)
+					continue;
+
+				const FactionGlyph comboCell = GetCell(firstRow + c * rowStep, firstCol + c * colStep);
+				if(comboCell == FG_None)
+					score += 1;
+				else if(comboCell == glyph)
+					score += 2;
+				else
+					score -= 3;
 			}
-		}
 
-		//	Cell not in this combo? Skip
-		if(comboIndex < 0)
-			continue;
-
-		//	Check if winning combo
-		int score = -5;
-		for(int c = 0; c < 3; c++)
-		{
-			if(c == comboIndex)
-				continue;
-			if(cells[winCombo[c]] == FG_None)
-				score += 1;
-			else if(cells[winCombo[c]] == glyph)
-				score += 2;
-			else
-				score -= 3;
+			//	If move makes a combo, return a high score
+			if(score > bestComboScore)
+				bestComboScore = score;
 		}
-
-		//	If move makes a combo, return a high score
-		if(score > bestComboScore)
-			bestComboScore = score;
 	}
 
 	return bestComboScore;
@@ -164,96 +157,81 @@ int Field::FindBestMove(FactionGlyph glyph, bool * isConclusiveMove) const
 	 */
 
 	//	Prepare decision making
-	int bestScore = -10;
+	const int runLength = board.GetRunLength();
+	const int baseScore = -(2 * runLength - 1);
+	int bestScore = baseScore - 1;
 	int bestMove = -1;
 
-	//	Find the best among the availabe moves
-	for(const int & move : emptyCells)
+	//	Find the best among the availabe moves (in cells order, so ties are always broken the same way)
+	if(MoveScorer::IsSupported(board.GetRules()))
 	{
-		const int row = move / 3;
-		const int col = move % 3;
-
-		const int moveScore = GetMoveScore(glyph, row, col);
-		if(moveScore > bestScore)
+		//	All cells scored at once, the same scores as one by one
+		const vector<int16_t> & moveScores = moveScorer.Score(board, glyph);
+		for(const int move : board.GetEmptyCells())
+			if(moveScores[move] > bestScore || (moveScores[move] == bestScore && move < bestMove))
+			{
+				bestScore = moveScores[move];
+				bestMove = move;
+			}
+	}
+	else
+	{
+		for(int move = 0; move < board.GetCellsCount(); move++)
 		{
-			bestScore = moveScore;
-			bestMove = move;
+			if(board.Get(move) != FG_None)
+				continue;
+
+			const int moveScore = GetMoveScore(glyph, board.GetRow(move), board.GetColumn(move));
+			if(moveScore > bestScore)
+			{
+				bestScore = moveScore;
+				bestMove = move;
+			}
 		}
 	}
 
-	//	Check if is a conclusive move
+	//	Check if is a conclusive move (all the other cells of the combo are own cells)
 	if(isConclusiveMove)
-		*isConclusiveMove = bestScore >= 4;
+		*isConclusiveMove = bestScore >= baseScore + 2 * (runLength - 1);
 
 	//	Return the best move
 	assert(bestMove > -1);
 	return bestMove;
 }
 
-bool Field::MakeMove(int row, int col, FactionGlyph glyph)
+bool Field::MakeMove(int cell, FactionGlyph glyph)
 {
-	//	Calculate linear index
-	int index = row * 3 + col;
-
-	//	Check that the cell is not already taken
-	if(cells[index] != FG_None)
+	//	Fill the cell with the move's glyph, fails if the cell is already taken
+	if(!board.MakeMove(cell, glyph))
 		return false;
-	
-	//	Fill the cell with the move's glyph
-	cells[index] = glyph;
+	boardDirty = true;
 
-	/*
-	 * Instead of iterating through the field, checking
-	 * empty cells and adding them to a vector every time
-	 * anybody needs to know what are empty cells, we
-	 * preferred storing a vector of empty cells and
-	 * modifying it any time the field changes.
-	 *
-	 * In this case we're taking the cell interested by the
-	 * current move out of the vector of empty cells.
-	 * This minimizes the interactions with the vector,
-	 * which may be heavy operations.
-	 *
-	 * See Field::Reset() for more details
-	 */
-
-	//	Remove cell from empty cells
-	emptyCells.erase(remove(emptyCells.begin(), emptyCells.end(), index));
-
-	return true;
-}
+	//	Record the move, and close the game in the log as soon as it's over
+	if(moveLog)
+	{
+		moveLog->Record(cell);
+		if(board.IsGameOver())
+			moveLog->EndGame();
+	}
 
-bool Field::IsFull() const
-{
-	for(int i = 0; i < 9; i++)
-		if(cells[i] == FG_None)
-			return false;
-	
 	return true;
 }
 
-FactionGlyph Field::GetWinner() const
+void Field::PreRender(SDL_Renderer * r)
 {
-	for(int combo = 0; combo < 8; combo++)
-		if(
-			cells[winCombos[combo][0]] != FG_None &&
-			cells[winCombos[combo][0]] == cells[winCombos[combo][1]] &&
-			cells[winCombos[combo][0]] == cells[winCombos[combo][2]]
-		)
-			return cells[winCombos[combo][0]];
-	
-	return FG_None;
-}
+	//	Refresh metrics, only if the assigned area changed
+	if(ConsumeLayoutDirty())
+	{
+		CalculateFieldMetrics();
 
-FactionGlyph Field::GetCell(int row, int col) const
-{
-	return cells[row * 3 + col];
-}
+		//	The board texture must match the new size (a new texture also replaces a lost one)
+		ReleaseBoardTexture();
+		boardDirty = true;
+	}
 
-void Field::PreRender(SDL_Renderer * r)
-{
-	//	Refresh metrics
-	CalculateFieldMetrics();
+	//	The board is only shown while the game is on, end game screens are drawn directly
+	if(boardDirty && IsGameOn())
+		RefreshBoardTexture(r);
 }
 
 void Field::Render(SDL_Renderer * r) const
@@ -269,55 +247,141 @@ void Field::Render(SDL_Renderer * r) const
 
 void Field::CalculateFieldMetrics()
 {
-	//	Calculate squared field area
-	const int axis = min(area.w, area.h);
-	fieldArea.w = axis;
-	fieldArea.h = axis;
+	//	Calculate the biggest squared cells that make the whole grid fit the area
+	cellSize = min(area.w / board.GetColumns(), area.h / board.GetRows());
+
+	//	Calculate field area, centered in the assigned area
+	fieldArea.w = cellSize * board.GetColumns();
+	fieldArea.h = cellSize * board.GetRows();
 	fieldArea.x = area.x + area.w / 2 - fieldArea.w / 2;
 	fieldArea.y = area.y + area.h / 2 - fieldArea.h / 2;
 
-	//	Calculate cells areas
-	const int cellSize = fieldArea.w / 3;
+	//	Calculate glyph radius
+	glyphRadius = max(1, (int)((cellSize - 10) / 2));
+}
 
-	for(int row = 0; row < 3; row++)
-		for(int col = 0; col < 3; col++)
-			cellsAreas[row][col] = {
-				fieldArea.x + col * cellSize,
-				fieldArea.y + row * cellSize,
-				cellSize,
-				cellSize
-		};
+SDL_Rect Field::GetCellArea(int row, int col) const
+{
+	return {
+		fieldArea.x + col * cellSize,
+		fieldArea.y + row * cellSize,
+		cellSize,
+		cellSize
+	};
+}
 
-	//	Calculate glyph radius
-	glyphRadius = (int)((cellSize - 10) / 2);
+SDL_Rect Field::GetBannerCellArea(int row, int col) const
+{
+	/*
+	 * End game banners are written on a 3x3 grid, whatever the
+	 * size of the board, inscribed in the field area.
+	 */
+	const int bannerCellSize = min(fieldArea.w, fieldArea.h) / 3;
+	return {
+		fieldArea.x + fieldArea.w / 2 - (bannerCellSize * 3) / 2 + col * bannerCellSize,
+		fieldArea.y + fieldArea.h / 2 - (bannerCellSize * 3) / 2 + row * bannerCellSize,
+		bannerCellSize,
+		bannerCellSize
+	};
 }
 
-void Field::RenderGameScreen(SDL_Renderer * r) const
+void Field::RefreshBoardTexture(SDL_Renderer * r)
+{
+	if(!boardTexture)
+	{
+		boardTexture = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, fieldArea.w, fieldArea.h);
+		if(!boardTexture)
+			return;	//	No render targets (or no area at all), the board will be drawn directly
+
+		/*
+		 * Drawing with alpha blending on a transparent texture
+		 * leaves colors already multiplied by their alpha (e.g.
+		 * on anti-aliased edges), so the texture must be blended
+		 * as premultiplied, or edges would be darkened twice.
+		 * Renderers that can't fall back to plain blending.
+		 */
+		const SDL_BlendMode premultipliedBlendMode = SDL_ComposeCustomBlendMode(
+			SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+			SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+		);
+		if(SDL_SetTextureBlendMode(boardTexture, premultipliedBlendMode) != 0)
+			SDL_SetTextureBlendMode(boardTexture, SDL_BLENDMODE_BLEND);
+	}
+
+	//	Whatever is pending belongs to the current target, draw it before switching
+	FlushDrawing(r);
+	SDL_Texture * previousTarget = SDL_GetRenderTarget(r);
+	if(SDL_SetRenderTarget(r, boardTexture) != 0)
+	{
+		ReleaseBoardTexture();
+		return;
+	}
+
+	//	Draw the board at the texture's origin
+	SDL_SetRenderDrawColor(r, COL_BOARD_CLEAR);
+	SDL_RenderClear(r);
+	RenderBoard(r, -fieldArea.x, -fieldArea.y);
+	FlushDrawing(r);
+
+	SDL_SetRenderTarget(r, previousTarget);
+	boardDirty = false;
+}
+
+void Field::ReleaseBoardTexture()
 {
-	for(int row = 0; row < 3; row++)
-		for(int col = 0; col < 3; col++)
+	if(boardTexture)
+	{
+		SDL_DestroyTexture(boardTexture);
+		boardTexture = nullptr;
+	}
+}
+
+void Field::RenderBoard(SDL_Renderer * r, int offsetX, int offsetY) const
+{
+	for(int row = 0; row < board.GetRows(); row++)
+		for(int col = 0; col < board.GetColumns(); col++)
 		{
-			SDL_SetRenderDrawColor(r, COL_FIELD);
-			SDL_RenderDrawRect(r, &cellsAreas[row][col]);
+			SDL_Rect cellArea = GetCellArea(row, col);
+			cellArea.x += offsetX;
+			cellArea.y += offsetY;
+			DrawOutline(r, &cellArea, {COL_FIELD});
 			DrawGlyph(
 				r,
 				GetCell(row, col),
-				cellsAreas[row][col].x + cellsAreas[row][col].w / 2,
-				cellsAreas[row][col].y + cellsAreas[row][col].h / 2,
+				cellArea.x + cellArea.w / 2,
+				cellArea.y + cellArea.h / 2,
 				glyphRadius
 			);
 		}
 }
 
+void Field::RenderGameScreen(SDL_Renderer * r) const
+{
+	//	No up to date texture, draw the board as it is
+	if(!boardTexture || boardDirty)
+	{
+		RenderBoard(r, 0, 0);
+		return;
+	}
+
+	//	Keep the drawing order: what's pending goes below the board
+	FlushDrawing(r);
+	SDL_RenderCopy(r, boardTexture, nullptr, &fieldArea);
+}
+
 void Field::RenderGameDrawScreen(SDL_Renderer * r) const
 {
 	assert(IsFull());	//	Shouldn't render draw screen if not actually draw
 
 	//	Draw the "draw" word scattered among the cells
-	DrawChar(r, &cellsAreas[0][0], 'd');
-	DrawChar(r, &cellsAreas[0][1], 'r');
-	DrawChar(r, &cellsAreas[1][1], 'a');
-	DrawChar(r, &cellsAreas[1][2], 'w');
+	SDL_Rect bannerCellArea = GetBannerCellArea(0, 0);
+	DrawChar(r, &bannerCellArea, 'd');
+	bannerCellArea = GetBannerCellArea(0, 1);
+	DrawChar(r, &bannerCellArea, 'r');
+	bannerCellArea = GetBannerCellArea(1, 1);
+	DrawChar(r, &bannerCellArea, 'a');
+	bannerCellArea = GetBannerCellArea(1, 2);
+	DrawChar(r, &bannerCellArea, 'w');
 }
 
 void Field::RenderGameWonScreen(SDL_Renderer * r) const
@@ -325,17 +389,22 @@ void Field::RenderGameWonScreen(SDL_Renderer * r) const
 	assert(GetWinner() != FG_None);	//	Shouldn't render win screen if there's no winner
 
 	//	Draw the winner's glyph
+	SDL_Rect bannerCellArea = GetBannerCellArea(0, 1);
 	DrawGlyph(
 		r,
 		GetWinner(),
-		cellsAreas[0][1].x + cellsAreas[0][1].w / 2,
-		cellsAreas[0][1].y + cellsAreas[0][1].h / 2,
-		glyphRadius
+		bannerCellArea.x + bannerCellArea.w / 2,
+		bannerCellArea.y + bannerCellArea.h / 2,
+		max(1, (bannerCellArea.w - 10) / 2)
 	);
 
 	//	Draw the "wins" word scattered among the cells
-	DrawChar(r, &cellsAreas[1][0], 'w');
-	DrawChar(r, &cellsAreas[1][1], 'i');
-	DrawChar(r, &cellsAreas[2][1], 'n');
-	DrawChar(r, &cellsAreas[2][2], 's');
+	bannerCellArea = GetBannerCellArea(1, 0);
+	DrawChar(r, &bannerCellArea, 'w');
+	bannerCellArea = GetBannerCellArea(1, 1);
+	DrawChar(r, &bannerCellArea, 'i');
+	bannerCellArea = GetBannerCellArea(2, 1);
+	DrawChar(r, &bannerCellArea, 'n');
+	bannerCellArea = GetBannerCellArea(2, 2);
+	DrawChar(r, &bannerCellArea, 's');
 }
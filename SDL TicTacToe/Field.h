@@ -1,26 +1,32 @@
 #pragma once
 
-#pragma region C++ Includdes
-#include <vector>
-#pragma endregion
-
 #pragma region Engine Includes
 #include "IRenderable.h"
 #pragma endregion
 
 #pragma region Game Includes
 #include "Tokens.h"
+#include "Board.h"
+#include "MoveLog.h"
+#include "MoveScorer.h"
 #pragma endregion
 
 using namespace std;
 
 /*
  * Class representing the game field of the Tic-Tac-Toe game.
- * It manages a 3x3 grid and exposes methods to interact with
- * it, as well as methods to make, evaluate and find moves.
+ * It manages a grid (3x3 by default, but any size works) and
+ * exposes methods to interact with it, as well as methods to
+ * make, evaluate and find moves.
  * Also exposes a set of methods to query the state of the
  * game based on the contents of the grid.
  * 
+ * The grid itself is stored in a Board, which keeps the game
+ * state up to date move by move, so queries on the game state
+ * are cheap enough to be called many times per frame, and so
+ * the board can be copied out for speculation without dragging
+ * along the rendering data.
+ * 
  * Many AI-related funcitons have been implemented as part of
  * this Field class, instead of being part of the AI controller
  * class. In the scope of this project, it makes no difference
@@ -34,6 +40,13 @@ using namespace std;
  *		the Field class
  * - scalability: these functions may also be relevant to a
  *		player-aid functionallity to make hints or tutorials
+ *
+ * While the game is on, the grid and the placed glyphs only
+ * change on moves, resets and layout changes, so they're drawn
+ * once into a texture and each frame just copies it: the
+ * texture is drawn again, during PreRender, only after one of
+ * those. Renderers with no render targets draw the board every
+ * frame instead.
  */
 class Field : public IRenderable
 {
@@ -43,32 +56,41 @@ protected:
 private:
 	const SDL_Rect & area;
 	SDL_Rect fieldArea;
-	SDL_Rect cellsAreas[3][3];
+	int cellSize;
 	int glyphRadius;
-	FactionGlyph cells[9];
-	vector<int> emptyCells;
+	Board board;
+	MoveLog * moveLog = nullptr;
+	mutable MoveScorer moveScorer;	//	Scratch buffers only, moves are looked for by one thread at a time
+	SDL_Texture * boardTexture = nullptr;
+	bool boardDirty = true;
 	// Constructors
 public:
-	Field(const SDL_Rect & area);
+	Field(const SDL_Rect & area, const BoardRules & rules = BoardRules());
+	~Field();
+	//	The board texture is owned, no copies
+	Field(const Field &) = delete;
+	Field & operator=(const Field &) = delete;
 protected:
 private:
-	static int winCombos[8][3];
 	// Methods
 public:
 	void Reset();
+	__inline void SetMoveLog(MoveLog * log) { moveLog = log; }
 	bool TestCell(SDL_Point point, int & row, int & col) const;
-	__inline const vector<int> & GetEmptyCells() const { return emptyCells; }
+	__inline const Board & GetBoard() const { return board; }
+	__inline const vector<int> & GetEmptyCells() const { return board.GetEmptyCells(); }
 	int GetRandomEmptyCell() const;
 	int GetMoveScore(FactionGlyph glyph, int row, int col) const;
 	int FindBestMove(FactionGlyph glyph, bool * isConclusiveMove = nullptr) const;
-	bool MakeMove(int row, int col, FactionGlyph glyph);
-	bool IsFull() const;
+	bool MakeMove(int row, int col, FactionGlyph glyph) { return MakeMove(board.ToCell(row, col), glyph); }
+	bool MakeMove(int cell, FactionGlyph glyph);
+	bool IsFull() const { return board.IsFull(); }
 	bool IsGameWon() const { return GetWinner() != FG_None; }
 	bool IsGameDraw() const { return !IsGameWon() && IsFull(); }
-	bool IsGameOver() const { return IsGameWon() || IsGameDraw(); }
+	bool IsGameOver() const { return board.IsGameOver(); }
 	bool IsGameOn() const { return !IsGameOver(); }
-	FactionGlyph GetWinner() const;
-	FactionGlyph GetCell(int row, int col) const;
+	FactionGlyph GetWinner() const { return board.GetWinner(); }
+	FactionGlyph GetCell(int row, int col) const { return board.Get(row, col); }
 
 	//	IRenderable implementation
 	const SDL_Rect & GetRect() const override { return fieldArea; }
@@ -77,6 +99,11 @@ public:
 protected:
 private:
 	void CalculateFieldMetrics();
+	SDL_Rect GetCellArea(int row, int col) const;
+	SDL_Rect GetBannerCellArea(int row, int col) const;
+	void RefreshBoardTexture(SDL_Renderer * r);
+	void ReleaseBoardTexture();
+	void RenderBoard(SDL_Renderer * r, int offsetX, int offsetY) const;
 	void RenderGameScreen(SDL_Renderer * r) const;
 	void RenderGameDrawScreen(SDL_Renderer * r) const;
 	void RenderGameWonScreen(SDL_Renderer * r) const;
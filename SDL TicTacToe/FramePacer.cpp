@@ -0,0 +1,69 @@
+#include "FramePacer.h"
+
+#pragma region C++ Includes
+#include <thread>
+#pragma endregion
+
+#pragma region SDL Includes
+#include <SDL_timer.h>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Wait left to busy waiting, enough to cover a late wake-up from sleep
+#define SPIN_MICROS 2000
+#pragma endregion
+
+FramePacer::FramePacer() :
+	spinTime(duration_cast<steady_clock::duration>(microseconds(SPIN_MICROS)))
+{
+}
+
+void FramePacer::SetTargetFPS(int fps)
+{
+	framePeriod = fps > 0 ? duration_cast<steady_clock::duration>(duration<double>(1.0 / fps)) : steady_clock::duration::zero();
+	scheduled = false;
+}
+
+void FramePacer::WaitForNextFrame()
+{
+	if(!IsPacing())
+		return;
+
+	steady_clock::time_point now = steady_clock::now();
+
+	//	First frame of the schedule, the next one is due a period from now
+	if(!scheduled)
+	{
+		nextFrame = now + framePeriod;
+		scheduled = true;
+		return;
+	}
+
+	//	Late already
+	if(now >= nextFrame)
+	{
+		if(!frameSkip)
+		{
+			nextFrame = now + framePeriod;
+			return;
+		}
+
+		const auto missedFrames = (now - nextFrame) / framePeriod + 1;
+		nextFrame += missedFrames * framePeriod;
+	}
+
+	//	Sleep through most of the wait, in whole milliseconds as that's what SDL can sleep for
+	const steady_clock::duration sleepTime = nextFrame - now - spinTime;
+	if(sleepTime > steady_clock::duration::zero())
+	{
+		const long long sleepMillis = duration_cast<milliseconds>(sleepTime).count();
+		if(sleepMillis > 0)
+			SDL_Delay((Uint32)sleepMillis);
+	}
+
+	//	Then spin through the rest, letting other threads run in the meantime
+	while((now = steady_clock::now()) < nextFrame)
+		this_thread::yield();
+
+	nextFrame += framePeriod;
+}
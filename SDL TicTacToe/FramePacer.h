@@ -0,0 +1,58 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <chrono>
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Keeps frames evenly spaced at a target frame rate.
+ * Frames are due on a fixed schedule (every period from the
+ * first one) rather than a period after the previous one
+ * ended, so errors don't add up frame after frame.
+ *
+ * Sleeping is cheap but imprecise, the system wakes threads
+ * up late by up to a scheduler tick (about a millisecond, or
+ * worse, on some systems), while busy waiting is precise but
+ * burns a core: so the pacer sleeps for most of the wait and
+ * spins through the last bit of it.
+ *
+ * When a frame is late there are two roads to walk:
+ * - variable frame time: rush into the next frame, and start
+ *		the schedule over from there
+ * - fixed frame time (frame skip): wait for the next frame due
+ *		on the schedule, skipping the ones that were missed
+ */
+class FramePacer
+{
+	// Fields
+public:
+protected:
+private:
+	steady_clock::duration framePeriod = steady_clock::duration::zero();
+	steady_clock::duration spinTime;
+	steady_clock::time_point nextFrame;
+	bool scheduled = false;
+	bool frameSkip = false;
+	// Constructors
+public:
+	FramePacer();
+protected:
+private:
+	// Methods
+public:
+	//	Zero or less for no pacing at all (e.g. when presenting waits for VSync already)
+	void SetTargetFPS(int fps);
+	__inline bool IsPacing() const { return framePeriod > steady_clock::duration::zero(); }
+	__inline void SetFrameSkip(bool newFrameSkip) { frameSkip = newFrameSkip; }
+
+	//	Starts the schedule over from now, e.g. after idling for a while
+	__inline void Reset() { scheduled = false; }
+
+	//	Returns when the next frame is due
+	void WaitForNextFrame();
+protected:
+private:
+};
@@ -0,0 +1,136 @@
+#include "FrameProfiler.h"
+
+#pragma region C++ Includes
+#include <fstream>
+#include <iomanip>
+#pragma endregion
+
+void FrameProfiler::Enable(size_t capacity)
+{
+	samples.assign(capacity > 0 ? capacity : 1, FrameSample());
+	nextSample = 0;
+	samplesCount = 0;
+	origin = steady_clock::now();
+	enabled = true;
+}
+
+void FrameProfiler::BeginFrame()
+{
+	if(!enabled)
+		return;
+
+	lastMark = steady_clock::now();
+	currentSample = FrameSample();
+	currentSample.startMicros = duration_cast<duration<double, micro>>(lastMark - origin).count();
+}
+
+void FrameProfiler::EndPhase(FramePhase phase)
+{
+	if(!enabled)
+		return;
+
+	//	The phase started where the previous one ended
+	const steady_clock::time_point now = steady_clock::now();
+	currentSample.phaseMicros[phase] += duration_cast<duration<float, micro>>(now - lastMark).count();
+	lastMark = now;
+}
+
+void FrameProfiler::EndFrame()
+{
+	if(!enabled)
+		return;
+
+	//	Overwrite the oldest frame once the buffer is full
+	samples[nextSample] = currentSample;
+	nextSample = (nextSample + 1) % samples.size();
+	if(samplesCount < samples.size())
+		samplesCount++;
+}
+
+bool FrameProfiler::SaveCSV(const char * path) const
+{
+	ofstream file(path);
+	if(!file)
+		return false;
+
+	//	One row per frame, oldest first, times in milliseconds
+	file << "frame,start_ms";
+	for(int phase = 0; phase < FP_Count; phase++)
+		file << "," << GetPhaseName((FramePhase)phase) << "_ms";
+	file << ",total_ms\n";
+
+	file << fixed << setprecision(3);
+	for(size_t age = samplesCount; age-- > 0; )
+	{
+		const FrameSample & sample = GetSample(age);
+		float totalMicros = 0.0f;
+		file << samplesCount - 1 - age << "," << sample.startMicros / 1000.0;
+		for(const float phaseMicros : sample.phaseMicros)
+		{
+			file << "," << phaseMicros / 1000.0f;
+			totalMicros += phaseMicros;
+		}
+		file << "," << totalMicros / 1000.0f << "\n";
+	}
+
+	return (bool)file;
+}
+
+bool FrameProfiler::SaveChromeTrace(const char * path) const
+{
+	ofstream file(path);
+	if(!file)
+		return false;
+
+	/*
+	 * Trace Event Format: a complete event ("ph": "X") for each
+	 * frame and, nested in it, one for each phase. Phases run
+	 * one after the other, so each one starts where the
+	 * previous one ends.
+	 */
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	file << fixed << setprecision(3);
+	bool firstEvent = true;
+	for(size_t age = samplesCount; age-- > 0; )
+	{
+		const FrameSample & sample = GetSample(age);
+		float totalMicros = 0.0f;
+		for(const float phaseMicros : sample.phaseMicros)
+			totalMicros += phaseMicros;
+
+		file << (firstEvent ? "\n" : ",\n");
+		file << "{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << sample.startMicros << ",\"dur\":" << totalMicros << "}";
+		firstEvent = false;
+
+		double phaseStartMicros = sample.startMicros;
+		for(int phase = 0; phase < FP_Count; phase++)
+		{
+			file << ",\n{\"name\":\"" << GetPhaseName((FramePhase)phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << phaseStartMicros << ",\"dur\":" << sample.phaseMicros[phase] << "}";
+			phaseStartMicros += sample.phaseMicros[phase];
+		}
+	}
+	file << "\n]}\n";
+
+	return (bool)file;
+}
+
+const char * FrameProfiler::GetPhaseName(FramePhase phase)
+{
+	switch(phase)
+	{
+		case FP_PollEvents:
+			return "poll_events";
+		case FP_Update:
+			return "update";
+		case FP_PreRender:
+			return "pre_render";
+		case FP_Render:
+			return "render";
+		case FP_Present:
+			return "present";
+		case FP_Sleep:
+			return "sleep";
+		default:
+			return "unknown";
+	}
+}
@@ -0,0 +1,110 @@
+#include "FrameTimeGraph.h"
+
+#pragma region C++ Includes
+#include <algorithm>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "Input.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "Drawing.h"
+#pragma endregion
+
+using namespace std;
+
+#pragma region Constant Parameters
+#define TOGGLE_KEY SDLK_F3
+
+//	Layout, relative to the viewport
+#define GRAPH_WIDTH_RATIO 3
+#define GRAPH_HEIGHT_RATIO 5
+#define GRAPH_MARGIN 8
+#define BAR_WIDTH 3
+
+//	The graph fits twice the frame budget, so slow frames still show how slow they are
+#define BUDGET_SCALE 2.0f
+
+//	Color palette, one color per phase (in FramePhase order)
+#define COL_BACKGROUND SDL_Color{16, 16, 16, 255}
+#define COL_BUDGET SDL_Color{220, 220, 220, 255}
+static const SDL_Color PhaseColors[FP_Count] =
+{
+	{ 243, 200, 12, 255 },	//	Poll events
+	{ 12, 200, 100, 255 },	//	Update
+	{ 120, 60, 220, 255 },	//	Pre-render
+	{ 12, 52, 243, 255 },	//	Render
+	{ 243, 32, 12, 255 },	//	Present
+	{ 60, 60, 60, 255 }	//	Sleep
+};
+#pragma endregion
+
+FrameTimeGraph::FrameTimeGraph(const FrameProfiler & profiler, const SDL_Rect & viewport, float frameBudgetMillis, bool visible) :
+	profiler(profiler),
+	viewport(viewport),
+	frameBudgetMillis(frameBudgetMillis),
+	visible(visible)
+{
+	CalculateGraphMetrics();
+}
+
+void FrameTimeGraph::Update()
+{
+	if(Input::Get().GetButtonPressed(TOGGLE_KEY))
+		visible = !visible;
+}
+
+void FrameTimeGraph::PreRender(SDL_Renderer * /* r */)
+{
+	if(ConsumeLayoutDirty())
+		CalculateGraphMetrics();
+}
+
+void FrameTimeGraph::Render(SDL_Renderer * r) const
+{
+	if(!visible || graphArea.w <= 0 || graphArea.h <= 0)
+		return;
+
+	DrawBar(r, &graphArea, COL_BACKGROUND);
+
+	/*
+	 * Walk frames from the newest, drawing bars from the right
+	 * edge leftwards, until the graph is full or frames are
+	 * over. Each phase is a segment stacked on the previous
+	 * one, clipped to the top of the graph.
+	 */
+	const float pixelsPerMicro = graphArea.h / (frameBudgetMillis * BUDGET_SCALE * 1000.0f);
+	const int bottom = graphArea.y + graphArea.h;
+	const size_t barsCount = min(profiler.GetSamplesCount(), (size_t)(graphArea.w / BAR_WIDTH));
+	for(size_t age = 0; age < barsCount; age++)
+	{
+		const FrameSample & sample = profiler.GetSample(age);
+		const int x = graphArea.x + graphArea.w - (int)(age + 1) * BAR_WIDTH;
+		float stackedMicros = 0.0f;
+		int stackedPixels = 0;
+		for(int phase = 0; phase < FP_Count && stackedPixels < graphArea.h; phase++)
+		{
+			stackedMicros += sample.phaseMicros[phase];
+			const int topPixels = min(graphArea.h, (int)(stackedMicros * pixelsPerMicro));
+			if(topPixels > stackedPixels)
+			{
+				const SDL_Rect segment{x, bottom - topPixels, BAR_WIDTH, topPixels - stackedPixels};
+				DrawBar(r, &segment, PhaseColors[phase]);
+				stackedPixels = topPixels;
+			}
+		}
+	}
+
+	//	Frame budget line
+	const int budgetY = bottom - (int)(graphArea.h / BUDGET_SCALE);
+	DrawLine(r, graphArea.x, budgetY, graphArea.x + graphArea.w - 1, budgetY, COL_BUDGET);
+}
+
+void FrameTimeGraph::CalculateGraphMetrics()
+{
+	graphArea.w = viewport.w / GRAPH_WIDTH_RATIO;
+	graphArea.h = viewport.h / GRAPH_HEIGHT_RATIO;
+	graphArea.x = viewport.x + GRAPH_MARGIN;
+	graphArea.y = viewport.y + viewport.h - graphArea.h - GRAPH_MARGIN;
+}
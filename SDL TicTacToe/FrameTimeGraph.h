@@ -0,0 +1,50 @@
+#pragma once
+
+#pragma region Engine Includes
+#include "IUpdatable.h"
+#include "IRenderable.h"
+#include "FrameProfiler.h"
+#pragma endregion
+
+/*
+ * Debug overlay showing the most recent frames captured by a
+ * frame profiler: one stacked bar per frame, one color per
+ * phase, newest on the right, with a line marking the frame
+ * budget. Sleep time is part of the bar, so a frame using its
+ * budget exactly touches the line and the time left to spare
+ * is the top (sleep) segment.
+ * It sits in the bottom-left corner of the viewport and it's
+ * toggled with F3.
+ */
+class FrameTimeGraph : public IUpdatable, public IRenderable
+{
+	// Fields
+public:
+protected:
+private:
+	const FrameProfiler & profiler;
+	const SDL_Rect & viewport;
+	SDL_Rect graphArea;
+	float frameBudgetMillis;
+	bool visible;
+	// Constructors
+public:
+	FrameTimeGraph(const FrameProfiler & profiler, const SDL_Rect & viewport, float frameBudgetMillis, bool visible = true);
+protected:
+private:
+	// Methods
+public:
+	__inline void SetVisible(bool newVisible) { visible = newVisible; }
+	__inline bool IsVisible() const { return visible; }
+
+	//	IUpdatable implementation
+	void Update() override;
+
+	//	IRenderable implementation
+	const SDL_Rect & GetRect() const override { return graphArea; }
+	void PreRender(SDL_Renderer * r) override;
+	void Render(SDL_Renderer * r) const override;
+protected:
+private:
+	void CalculateGraphMetrics();
+};
@@ -0,0 +1,137 @@
+#include "GeometryBatch.h"
+
+#pragma region C++ Includes
+#include <cmath>
+#include <algorithm>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Anti-aliasing feather, each edge fades out over one pixel centered on it
+#define FEATHER_HALF_WIDTH 0.5f
+#pragma endregion
+
+void GeometryBatch::AddStroke(float x1, float y1, float x2, float y2, float width, SDL_Color color)
+{
+	/*
+	 * The stroke is a 4x4 grid of vertices laid along its
+	 * direction: the inner 2x2 vertices hold the color, the
+	 * outer ones are transparent, so the 8 quads around the
+	 * inner one are the feather. Caps extend past the ends
+	 * by half the width, so strokes sharing an end join with
+	 * no notch.
+	 */
+	const float dx = x2 - x1;
+	const float dy = y2 - y1;
+	const float length = sqrt(dx * dx + dy * dy);
+	const float directionX = length > 0.0f ? dx / length : 1.0f;
+	const float directionY = length > 0.0f ? dy / length : 0.0f;
+	const float halfWidth = max(width, 1.0f) / 2;
+
+	const float along[4] = {
+		-halfWidth - FEATHER_HALF_WIDTH,
+		-halfWidth + FEATHER_HALF_WIDTH,
+		length + halfWidth - FEATHER_HALF_WIDTH,
+		length + halfWidth + FEATHER_HALF_WIDTH
+	};
+	const float across[4] = {
+		-halfWidth - FEATHER_HALF_WIDTH,
+		-halfWidth + FEATHER_HALF_WIDTH,
+		halfWidth - FEATHER_HALF_WIDTH,
+		halfWidth + FEATHER_HALF_WIDTH
+	};
+
+	const SDL_Color transparent = {color.r, color.g, color.b, 0};
+	const int firstVertex = (int)vertices.size();
+	for(int i = 0; i < 4; i++)
+		for(int j = 0; j < 4; j++)
+		{
+			const bool inner = i > 0 && i < 3 && j > 0 && j < 3;
+			AddVertex(
+				x1 + directionX * along[i] - directionY * across[j],
+				y1 + directionY * along[i] + directionX * across[j],
+				inner ? color : transparent
+			);
+		}
+
+	for(int i = 0; i < 3; i++)
+		for(int j = 0; j < 3; j++)
+		{
+			const int topLeft = firstVertex + i * 4 + j;
+			AddQuad(topLeft, topLeft + 1, topLeft + 4, topLeft + 5);
+		}
+}
+
+void GeometryBatch::AddRing(float x, float y, float radius, float width, const SDL_FPoint * unitCircle, int pointsCount, SDL_Color color)
+{
+	/*
+	 * Four concentric rings of vertices, one per point of the
+	 * unit circle: the two inner rings hold the color, the
+	 * innermost and outermost are transparent. Each point of
+	 * the unit circle is also the normal of the ring there,
+	 * so no trigonometry at all.
+	 */
+	const float halfWidth = max(width, 1.0f) / 2;
+	const float radii[4] = {
+		max(radius - halfWidth - FEATHER_HALF_WIDTH, 0.0f),
+		max(radius - halfWidth + FEATHER_HALF_WIDTH, 0.0f),
+		radius + halfWidth - FEATHER_HALF_WIDTH,
+		radius + halfWidth + FEATHER_HALF_WIDTH
+	};
+
+	const SDL_Color transparent = {color.r, color.g, color.b, 0};
+	const int firstVertex = (int)vertices.size();
+	for(int point = 0; point < pointsCount; point++)
+		for(int ring = 0; ring < 4; ring++)
+			AddVertex(
+				x + unitCircle[point].x * radii[ring],
+				y + unitCircle[point].y * radii[ring],
+				ring == 1 || ring == 2 ? color : transparent
+			);
+
+	for(int point = 0; point < pointsCount; point++)
+	{
+		const int current = firstVertex + point * 4;
+		const int next = firstVertex + ((point + 1) % pointsCount) * 4;
+		for(int ring = 0; ring < 3; ring++)
+			AddQuad(current + ring, current + ring + 1, next + ring, next + ring + 1);
+	}
+}
+
+void GeometryBatch::AddRect(const SDL_Rect & rect, SDL_Color color)
+{
+	//	Edges on pixel boundaries, nothing to smooth
+	const int topLeft = AddVertex((float)rect.x, (float)rect.y, color);
+	AddVertex((float)(rect.x + rect.w), (float)rect.y, color);
+	AddVertex((float)rect.x, (float)(rect.y + rect.h), color);
+	AddVertex((float)(rect.x + rect.w), (float)(rect.y + rect.h), color);
+	AddQuad(topLeft, topLeft + 1, topLeft + 2, topLeft + 3);
+}
+
+void GeometryBatch::Flush(SDL_Renderer * r)
+{
+	if(IsEmpty())
+		return;
+
+	//	Untextured geometry follows the draw blend mode, feathers need blending
+	SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+	SDL_RenderGeometry(r, nullptr, vertices.data(), (int)vertices.size(), indices.data(), (int)indices.size());
+
+	vertices.clear();
+	indices.clear();
+}
+
+int GeometryBatch::AddVertex(float x, float y, SDL_Color color)
+{
+	vertices.push_back({{x, y}, color, {0.0f, 0.0f}});
+	return (int)vertices.size() - 1;
+}
+
+void GeometryBatch::AddQuad(int topLeft, int topRight, int bottomLeft, int bottomRight)
+{
+	indices.push_back(topLeft);
+	indices.push_back(topRight);
+	indices.push_back(bottomLeft);
+	indices.push_back(topRight);
+	indices.push_back(bottomRight);
+	indices.push_back(bottomLeft);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#pragma endregion
+
+#pragma region SDL Includes
+#include <SDL.h>
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Collects untextured triangles (strokes, rings and filled
+ * rects) into a single vertex buffer, to be submitted with a
+ * single SDL_RenderGeometry call: the cost of drawing stops
+ * growing with the number of shapes, since the renderer only
+ * sees one draw call per flush.
+ *
+ * Strokes and rings are anti-aliased by surrounding them with
+ * a one pixel wide feather, whose outer vertices are fully
+ * transparent: the GPU blends it for free while interpolating
+ * vertex colors, so anti-aliasing takes more vertices but no
+ * more draw calls, whatever the stroke width.
+ *
+ * Buffers keep their memory between flushes, so once they've
+ * grown to fit the busiest frame no more allocations happen.
+ */
+class GeometryBatch
+{
+	// Fields
+public:
+protected:
+private:
+	vector<SDL_Vertex> vertices;
+	vector<int> indices;
+	// Constructors
+public:
+protected:
+private:
+	// Methods
+public:
+	//	A straight stroke of the given width from (x1, y1) to (x2, y2), with square caps
+	void AddStroke(float x1, float y1, float x2, float y2, float width, SDL_Color color);
+	//	A closed stroke around (x, y), given the unit circle points to follow
+	void AddRing(float x, float y, float radius, float width, const SDL_FPoint * unitCircle, int pointsCount, SDL_Color color);
+	//	A filled rect, covering the very same pixels SDL_RenderFillRect would cover
+	void AddRect(const SDL_Rect & rect, SDL_Color color);
+
+	__inline bool IsEmpty() const { return indices.empty(); }
+	__inline int GetVerticesCount() const { return (int)vertices.size(); }
+
+	//	Draws everything collected so far, in the order it was added, and starts over
+	void Flush(SDL_Renderer * r);
+protected:
+private:
+	int AddVertex(float x, float y, SDL_Color color);
+	void AddQuad(int topLeft, int topRight, int bottomLeft, int bottomRight);
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+/*
+ * Common interface for whatever carries messages to a player
+ * who is not sitting at this machine's input (a connection to
+ * another process, for instance). The RemoteTurnController
+ * uses it to tell the player when a move is expected and when
+ * the move received can't be made, while moves come back the
+ * other way through the controller itself.
+ */
+class IRemoteLink
+{
+public:
+	//	The opponent's last move, -1 when the game just started
+	virtual void RequestMove(int lastMove) = 0;
+	virtual void RejectMove(int cell) = 0;
+};
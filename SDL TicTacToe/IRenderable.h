@@ -5,12 +5,45 @@
 /*
  * Common interface for all objects that can be
  * displayed on a render target.
+ *
+ * Layout (the rects an object draws in) only changes
+ * when the viewport does, so objects keep it until
+ * they're told it's no longer valid: whoever notices
+ * the change invalidates the layout of the objects
+ * it owns, which in turn invalidate the layout of
+ * their own components when they recalculate theirs,
+ * during PreRender.
+ * Layout starts invalid, so it's calculated on the
+ * first PreRender anyway.
+ *
+ * Likewise, objects request a redraw when what they
+ * show changes, so a main loop that only draws on
+ * changes knows when to draw. A new layout always
+ * needs a redraw.
+ *
+ * The simulation runs in fixed steps while frames fall
+ * anywhere between them: before drawing, objects are
+ * told how far into the next step the frame is (from 0
+ * to 1), so anything moving can be drawn in between
+ * its last two positions. Objects that don't move can
+ * just ignore it.
  */
 class IRenderable
 {
+private:
+	bool layoutDirty = true;
+	bool redrawRequested = true;
 public:
+	virtual ~IRenderable() { }
 	virtual const SDL_Rect & GetRect() const = 0;
-	virtual void PreRender(SDL_Renderer * r) { }
+	virtual void Interpolate(float /* alpha */) { }
+	virtual void PreRender(SDL_Renderer * /* r */) { }
 	virtual void Render(SDL_Renderer * r) const = 0;
+	__inline void InvalidateLayout() { layoutDirty = true; redrawRequested = true; }
+	__inline void RequestRedraw() { redrawRequested = true; }
+	//	Returns whether a redraw was requested, and considers it served from now on
+	__inline bool ConsumeRedrawRequest() { const bool redrawRequestedCache = redrawRequested; redrawRequested = false; return redrawRequestedCache; }
+protected:
+	//	Returns whether the layout has to be calculated again, and considers it valid from now on
+	__inline bool ConsumeLayoutDirty() { const bool layoutDirtyCache = layoutDirty; layoutDirty = false; return layoutDirtyCache; }
 };
-
@@ -7,5 +7,6 @@
 class IUpdatable
 {
 public:
+	virtual ~IUpdatable() { }
 	virtual void Update() = 0;
 };
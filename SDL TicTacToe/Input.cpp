@@ -16,14 +16,16 @@ void Input::NotifyMousePosition(SDL_Point newMousePosition)
 
 }
 
-void Input::NotifyButtonPressed(SDL_Keycode buttonID)
+void Input::NotifyButtonPressed(const SDL_Keysym & keysym)
 {
-	buttonsState.Set((int)buttonID, true);
+	buttonsState.Set((int)keysym.sym, true);
+	scancodesState.Set((int)keysym.scancode, true);
 }
 
-void Input::NotifyButtonReleased(SDL_Keycode buttonID)
+void Input::NotifyButtonReleased(const SDL_Keysym & keysym)
 {
-	buttonsState.Set((int)buttonID, false);
+	buttonsState.Set((int)keysym.sym, false);
+	scancodesState.Set((int)keysym.scancode, false);
 }
 
 void Input::PollEvents()
@@ -32,11 +34,16 @@ void Input::PollEvents()
 	mouseButtonsState.Step();
 	mousePositionsState.Step();
 	buttonsState.Step();
+	scancodesState.Step();
+	windowResized = false;
+	eventsReceived = false;
+	renderTargetsReset = false;
 
 	//	Build new state
 	static SDL_Event ev;
 	while(SDL_PollEvent(&ev))
 	{
+		eventsReceived = true;
 		switch(ev.type)
 		{
 #ifndef __EMSCRIPTEN__
@@ -49,6 +56,14 @@ void Input::PollEvents()
 				quitRequested = true;
 				return;
 #endif
+			case SDL_WINDOWEVENT:	//	Same as above, but layout needs to know when the window is resized
+				if(ev.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+					windowResized = true;
+				break;
+			case SDL_RENDER_TARGETS_RESET:	//	Same as above, cached textures need to be drawn again
+			case SDL_RENDER_DEVICE_RESET:
+				renderTargetsReset = true;
+				break;
 			//	Mouse events
 			case SDL_MOUSEBUTTONDOWN:
 				NotifyMouseButtonPressed(ev.button.button);
@@ -63,10 +78,10 @@ void Input::PollEvents()
 				break;
 			//	Keyboard events
 			case SDL_KEYDOWN:
-				NotifyButtonPressed(ev.key.keysym.sym);
+				NotifyButtonPressed(ev.key.keysym);
 				break;
 			case SDL_KEYUP:
-				NotifyButtonReleased(ev.key.keysym.sym);
+				NotifyButtonReleased(ev.key.keysym);
 				break;
 			default:
 				break;
@@ -115,3 +130,18 @@ bool Input::GetButtonReleased(SDL_Keycode buttonId) const
 {
 	return buttonsState.GetReleased(buttonId);
 }
+
+bool Input::GetScancode(SDL_Scancode scancode) const
+{
+	return scancodesState.Get(scancode);
+}
+
+bool Input::GetScancodePressed(SDL_Scancode scancode) const
+{
+	return scancodesState.GetPressed(scancode);
+}
+
+bool Input::GetScancodeReleased(SDL_Scancode scancode) const
+{
+	return scancodesState.GetReleased(scancode);
+}
@@ -30,11 +30,19 @@ class Input
 public:
 protected:
 private:
-	ButtonsState mouseButtonsState;
-	AxesState mousePositionsState;	//	Would support multi-touch as positions are indexed
-	ButtonsState buttonsState;
+	static const int MouseButtonsCapacity = 32;	//	SDL numbers mouse buttons from 1, five of them have a name
+	static const int MousePositionsCapacity = 16;
+	static const int ButtonsCapacity = 512;	//	Well above the number of keys on any keyboard
+
+	ButtonsState<DenseSlots> mouseButtonsState{MouseButtonsCapacity};
+	AxesState<DenseSlots> mousePositionsState{MousePositionsCapacity};	//	Would support multi-touch as positions are indexed
+	ButtonsState<SparseSlots> buttonsState{ButtonsCapacity};	//	Keycodes, they depend on the keyboard layout
+	ButtonsState<DenseSlots> scancodesState{SDL_NUM_SCANCODES};	//	Physical keys, whatever the keyboard layout
 
 	bool quitRequested = false;
+	bool windowResized = false;
+	bool eventsReceived = false;
+	bool renderTargetsReset = false;
 	// Constructors
 public:
 	// Delete copy constructor and assignment operator (singleton protection)
@@ -77,6 +85,12 @@ public:
 	void PollEvents();
 
 	__inline bool WasQuitRequested() const { return quitRequested; }
+	//	Whether the window changed its size during this iteration
+	__inline bool WasWindowResized() const { return windowResized; }
+	//	Whether any event at all arrived during this iteration
+	__inline bool WereEventsReceived() const { return eventsReceived; }
+	//	Whether the contents of render target textures were lost during this iteration (e.g. on device loss)
+	__inline bool WereRenderTargetsReset() const { return renderTargetsReset; }
 
 	/*
 	 * The following functions are used to query the state of
@@ -88,6 +102,7 @@ public:
 	 * All require an id to identify what you're querying from that group:
 	 * - Mouse: an integer identifies the id of the button (SDL noation)
 	 * - Keyboard/Gamepad: an SDL_Keycode to identify the key
+	 * - Keyboard (physical position): an SDL_Scancode to identify the key
 	 * 
 	 * An exception is the mouse position. Despite internal support for
 	 * multiple mouse or multi-touch, mouse position and mouse delta do not
@@ -104,6 +119,10 @@ public:
 	bool GetButton(SDL_Keycode buttonId) const;
 	bool GetButtonPressed(SDL_Keycode buttonId) const;
 	bool GetButtonReleased(SDL_Keycode buttonId) const;
+
+	bool GetScancode(SDL_Scancode scancode) const;
+	bool GetScancodePressed(SDL_Scancode scancode) const;
+	bool GetScancodeReleased(SDL_Scancode scancode) const;
 protected:
 private:
 	/*
@@ -117,7 +136,7 @@ private:
 	__inline void NotifyMouseButtonPressed(int buttonId);
 	__inline void NotifyMouseButtonReleased(int buttonId);
 	__inline void NotifyMousePosition(SDL_Point newMousePosition);
-	__inline void NotifyButtonPressed(SDL_Keycode buttonID);
-	__inline void NotifyButtonReleased(SDL_Keycode buttonID);
+	__inline void NotifyButtonPressed(const SDL_Keysym & keysym);
+	__inline void NotifyButtonReleased(const SDL_Keysym & keysym);
 };
 
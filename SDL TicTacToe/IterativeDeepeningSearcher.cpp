@@ -0,0 +1,484 @@
+#include "IterativeDeepeningSearcher.h"
+
+#pragma region C++ Includes
+#include <algorithm>
+#include <cassert>
+#include <random>
+#pragma endregion
+
+#pragma region Constant Parameters
+#define DEADLINE_CHECK_NODES 256	//	Power of two, nodes searched between two looks at the clock
+#define NEIGHBOURHOOD_RADIUS 2	//	Cells farther than this from any glyph are not tried
+#define RUN_WEIGHT_SHIFT 3	//	Each glyph in a run makes it worth 8 times as much
+#define RUN_WEIGHT_MAX_SHIFT 12	//	Keeps the sum of all runs far from win scores, whatever the board
+#define ZOBRIST_SEED 0x7a6f62726973ull	//	Keys of its own, so the game's random numbers are left alone
+#pragma endregion
+
+using namespace std;
+
+namespace
+{
+	/*
+	 * Wins are worth more the sooner they come, counted from the
+	 * root: in the table they're counted from the position, so
+	 * they're worth the same wherever it's reached.
+	 */
+	__inline int ToTableScore(int score, int ply)
+	{
+		return score > IterativeDeepeningSearcher::WinScore / 2 ? score + ply : score < -IterativeDeepeningSearcher::WinScore / 2 ? score - ply : score;
+	}
+
+	__inline int FromTableScore(int score, int ply)
+	{
+		return score > IterativeDeepeningSearcher::WinScore / 2 ? score - ply : score < -IterativeDeepeningSearcher::WinScore / 2 ? score + ply : score;
+	}
+}
+
+IterativeDeepeningSearcher::IterativeDeepeningSearcher(const DeepeningSettings & settings) :
+	settings(settings)
+{
+}
+
+DeepeningResult IterativeDeepeningSearcher::Search(const Board & searchedBoard, FactionGlyph glyph, const atomic<bool> * cancelled, bool virtualTime)
+{
+	assert(glyph != FG_None);
+
+	DeepeningResult result;
+	if(searchedBoard.IsGameOver())
+		return result;
+
+	const steady_clock::time_point start = steady_clock::now();
+	deadline = start + milliseconds(settings.timeBudgetMillis);
+	nodesBudget = virtualTime ? max(1ull, (unsigned long long)settings.timeBudgetMillis * settings.virtualNodesPerMilli) : 0;
+	this->cancelled = cancelled;
+
+	Prepare();
+	if(table)
+		table->NewSearch();
+
+	if(helpers.empty() || virtualTime)
+		result = SearchRoot(searchedBoard, glyph, 0);
+	else
+	{
+		//	This thread runs the main search, the others a helper each, until the main search is over
+		atomic<bool> mainSearchOver(false);
+		vector<DeepeningResult> results(helpers.size() + 1);
+		pool->Run([&](int worker)
+		{
+			if(worker == 0)
+			{
+				results[0] = SearchRoot(searchedBoard, glyph, 0);
+				mainSearchOver.store(true, memory_order_relaxed);
+				return;
+			}
+
+			IterativeDeepeningSearcher & helper = *helpers[worker - 1];
+			helper.deadline = deadline;
+			helper.cancelled = cancelled;
+			helper.stopped = &mainSearchOver;
+			results[worker] = helper.SearchRoot(searchedBoard, glyph, worker);
+		});
+
+		//	A forced outcome stands, otherwise the deepest search completed, the main one on ties
+		result = results[0];
+		for(size_t r = 1; r < results.size(); r++)
+		{
+			const bool decisive = IsDecisive(results[r].score) && results[r].depthReached > 0;
+			if(!IsDecisive(result.score) && (decisive || results[r].depthReached > result.depthReached))
+			{
+				result.bestMove = results[r].bestMove;
+				result.score = results[r].score;
+				result.depthReached = results[r].depthReached;
+			}
+			result.nodesSearched += results[r].nodesSearched;
+		}
+	}
+
+	result.elapsedSeconds = duration<double>(steady_clock::now() - start).count();
+	return result;
+}
+
+void IterativeDeepeningSearcher::ClearTable()
+{
+	if(table)
+		table->Clear();
+}
+
+void IterativeDeepeningSearcher::Prepare()
+{
+	//	The table and the helpers are only made when searching, a searcher is cheap until then
+	if(!table && settings.tableMegabytes > 0)
+	{
+		ownTable.reset(new SharedTranspositionTable(settings.tableMegabytes));
+		table = ownTable.get();
+	}
+
+	if(!pool && settings.threadsCount != 1)
+	{
+		pool.reset(new ThreadPool(settings.threadsCount));
+
+		DeepeningSettings helperSettings = settings;
+		helperSettings.threadsCount = 1;
+		helperSettings.tableMegabytes = 0;
+		for(int worker = 1; worker < pool->GetWorkersCount(); worker++)
+		{
+			helpers.emplace_back(new IterativeDeepeningSearcher(helperSettings));
+			helpers.back()->table = table;
+		}
+	}
+}
+
+DeepeningResult IterativeDeepeningSearcher::SearchRoot(const Board & searchedBoard, FactionGlyph glyph, int helper)
+{
+	DeepeningResult result;
+	nodesSearched = 0;
+	aborted = false;
+
+	PrepareBoard(searchedBoard);
+	const int evaluation = Evaluate();
+
+	//	A winning move needs no search, otherwise the most promising move stands in until depth 1 is done
+	const int winningMove = GenerateMoves(0, glyph);
+	vector<ScoredMove> & rootMoves = movesByPly[0];
+	if(winningMove > -1)
+	{
+		result.bestMove = winningMove;
+		result.score = WinScore - 1;
+		result.depthReached = 1;
+	}
+	else
+	{
+		//	Best move of an earlier search first, then every helper on moves of its own, every other one a depth ahead
+		SharedTranspositionEntry entry;
+		if(table && table->Probe(GetPositionHash(glyph), entry))
+		{
+			const auto tableMove = find_if(rootMoves.begin(), rootMoves.end(), [&entry](const ScoredMove & m) { return m.move == entry.bestMove; });
+			if(tableMove != rootMoves.end())
+				rotate(rootMoves.begin(), tableMove, tableMove + 1);
+		}
+		result.bestMove = rootMoves[0].move;
+		if(helper > 0)
+			rotate(rootMoves.begin(), rootMoves.begin() + helper % rootMoves.size(), rootMoves.end());
+
+		const int emptyCellsCount = (int)board.GetEmptyCells().size();
+		const int maxDepth = settings.maxDepth > 0 ? min(settings.maxDepth, emptyCellsCount) : emptyCellsCount;
+		const FactionGlyph opponentGlyph = GetOpponentGlyph(glyph);
+		for(int depth = 1 + helper % 2; depth <= maxDepth; depth++)
+		{
+			int alpha = -WinScore;
+			int bestIndex = 0;
+			for(int m = 0; m < (int)rootMoves.size(); m++)
+			{
+				const ScoredMove & rootMove = rootMoves[m];
+				MakeMove(rootMove.move, glyph);
+				const int score = -Negamax(depth - 1, 1, -WinScore, -alpha, opponentGlyph, evaluation + rootMove.evaluationDelta);
+				UndoMove(rootMove.move);
+
+				if(aborted)
+					break;
+				if(score > alpha)
+				{
+					alpha = score;
+					bestIndex = m;
+				}
+			}
+
+			//	An unfinished depth can't be trusted, the last finished one stands
+			if(aborted)
+				break;
+
+			//	The best move goes first in the next depth, the others keep their order
+			rotate(rootMoves.begin(), rootMoves.begin() + bestIndex, rootMoves.begin() + bestIndex + 1);
+			result.bestMove = rootMoves[0].move;
+			result.score = alpha;
+			result.depthReached = depth;
+			if(table)
+				table->Store(GetPositionHash(glyph), alpha, result.bestMove, depth, BoundType::Exact);
+
+			//	Once the outcome is forced, deeper searches can't change it
+			if(IsDecisive(alpha))
+				break;
+		}
+	}
+
+	result.nodesSearched = nodesSearched;
+	return result;
+}
+
+int IterativeDeepeningSearcher::Negamax(int depth, int ply, int alpha, int beta, FactionGlyph glyph, int evaluation)
+{
+	if((++nodesSearched & (DEADLINE_CHECK_NODES - 1)) == 0 && IsTimeUp())
+		aborted = true;
+	if(aborted)
+		return 0;
+
+	//	The move leading here didn't win (the caller checks), so a full board is a draw
+	if(board.IsFull())
+		return 0;
+
+	//	Horizon, the position is scored by its lines, for the faction to move
+	if(depth == 0)
+		return glyph == FG_Cross ? evaluation : -evaluation;
+
+	/*
+	 * Searched already, deep enough? Its score may be all that's
+	 * needed, or at least narrow the window. Positions with a
+	 * win in one are never stored, so looking them up first is
+	 * safe, and saves generating the moves.
+	 */
+	const uint64_t positionHash = GetPositionHash(glyph);
+	SharedTranspositionEntry entry;
+	int tableMove = -1;
+	if(table && table->Probe(positionHash, entry))
+	{
+		tableMove = entry.bestMove;
+		if(entry.depth >= depth)
+		{
+			const int tableScore = FromTableScore(entry.score, ply);
+			if(entry.bound == BoundType::Exact)
+				return tableScore;
+			if(entry.bound == BoundType::LowerBound)
+				alpha = max(alpha, tableScore);
+			else if(entry.bound == BoundType::UpperBound)
+				beta = min(beta, tableScore);
+			if(alpha >= beta)
+				return tableScore;
+		}
+	}
+
+	//	Win in one, the sooner the better
+	if(GenerateMoves(ply, glyph) > -1)
+		return WinScore - (ply + 1);
+
+	vector<ScoredMove> & moves = movesByPly[ply];
+	if(tableMove > -1)
+	{
+		const auto tableMoveIt = find_if(moves.begin(), moves.end(), [tableMove](const ScoredMove & m) { return m.move == tableMove; });
+		if(tableMoveIt != moves.end())
+			rotate(moves.begin(), tableMoveIt, tableMoveIt + 1);
+	}
+
+	const FactionGlyph opponentGlyph = GetOpponentGlyph(glyph);
+	const int searchedAlpha = alpha;
+	int bestScore = -WinScore;
+	int bestMove = -1;
+	for(const ScoredMove & scoredMove : moves)
+	{
+		MakeMove(scoredMove.move, glyph);
+		const int score = -Negamax(depth - 1, ply + 1, -beta, -alpha, opponentGlyph, evaluation + scoredMove.evaluationDelta);
+		UndoMove(scoredMove.move);
+
+		if(aborted)
+			return 0;
+
+		if(score > bestScore)
+		{
+			bestScore = score;
+			bestMove = scoredMove.move;
+		}
+		if(score > alpha)
+			alpha = score;
+
+		//	The opponent won't allow this line, no need to look further
+		if(alpha >= beta)
+			break;
+	}
+
+	//	A score out of the window is only a bound
+	if(table)
+	{
+		const BoundType bound = bestScore <= searchedAlpha ? BoundType::UpperBound : bestScore >= beta ? BoundType::LowerBound : BoundType::Exact;
+		table->Store(positionHash, ToTableScore(bestScore, ply), bestMove, depth, bound);
+	}
+
+	return bestScore;
+}
+
+int IterativeDeepeningSearcher::GenerateMoves(int ply, FactionGlyph glyph)
+{
+	/*
+	 * Candidates are the empty cells close to some glyph (the
+	 * center on an empty board), ordered by how much they move
+	 * the score: what they give the faction to move plus what
+	 * they take from the opponent, who may want the same cell.
+	 * A winning move is returned as soon as it's met, without
+	 * going on, -1 otherwise.
+	 */
+	vector<ScoredMove> & moves = movesByPly[ply];
+	moves.clear();
+
+	const FactionGlyph opponentGlyph = GetOpponentGlyph(glyph);
+	const int sign = glyph == FG_Cross ? 1 : -1;
+	if(board.GetMovesCount() == 0)
+	{
+		const int center = board.ToCell(board.GetRows() / 2, board.GetColumns() / 2);
+		moves.push_back({center, 0, EvaluateMove(center, glyph)});
+		return -1;
+	}
+
+	for(const int cell : board.GetEmptyCells())
+	{
+		if(neighbours[cell] == 0)
+			continue;
+		if(board.IsWinningMove(cell, glyph))
+			return cell;
+
+		const int evaluationDelta = EvaluateMove(cell, glyph);
+		const int order = sign * evaluationDelta - sign * EvaluateMove(cell, opponentGlyph);
+		moves.push_back({cell, order, evaluationDelta});
+	}
+
+	//	Ties broken by cell, so the same position is always searched the same way
+	sort(moves.begin(), moves.end(), [](const ScoredMove & a, const ScoredMove & b) { return a.order != b.order ? a.order > b.order : a.move < b.move; });
+	return -1;
+}
+
+void IterativeDeepeningSearcher::MakeMove(int move, FactionGlyph glyph)
+{
+	board.MakeMove(move, glyph);
+	CountNeighbours(move, 1);
+	hash ^= zobristKeys[glyph == FG_Cross ? 0 : 1][move];
+}
+
+void IterativeDeepeningSearcher::UndoMove(int move)
+{
+	hash ^= zobristKeys[board.Get(move) == FG_Cross ? 0 : 1][move];
+	board.UndoMove(move);
+	CountNeighbours(move, -1);
+}
+
+void IterativeDeepeningSearcher::CountNeighbours(int move, int change)
+{
+	const int row = board.GetRow(move);
+	const int col = board.GetColumn(move);
+	for(int r = max(row - NEIGHBOURHOOD_RADIUS, 0); r <= min(row + NEIGHBOURHOOD_RADIUS, board.GetRows() - 1); r++)
+		for(int c = max(col - NEIGHBOURHOOD_RADIUS, 0); c <= min(col + NEIGHBOURHOOD_RADIUS, board.GetColumns() - 1); c++)
+			neighbours[board.ToCell(r, c)] += change;
+}
+
+void IterativeDeepeningSearcher::PrepareBoard(const Board & searchedBoard)
+{
+	//	Buffers are reused from search to search, they only grow with the board
+	board = searchedBoard;
+	neighbours.assign(board.GetCellsCount(), 0);
+	for(int cell = 0; cell < board.GetCellsCount(); cell++)
+		if(board.Get(cell) != FG_None)
+			CountNeighbours(cell, 1);
+
+	if(movesByPly.size() < (size_t)board.GetCellsCount() + 1)
+		movesByPly.resize(board.GetCellsCount() + 1);
+
+	/*
+	 * Keys are drawn from an engine of their own, seeded by the
+	 * rules, so they're the same for every searcher (helpers
+	 * share the table) and for every search on the same board.
+	 */
+	const BoardRules & rules = board.GetRules();
+	const uint64_t keysSeed = ZOBRIST_SEED ^ ((uint64_t)rules.columns << 32 | (uint64_t)rules.rows << 16 | (uint64_t)rules.runLength);
+	if(zobristKeys[0].size() != (size_t)board.GetCellsCount() || zobristSeed != keysSeed)
+	{
+		mt19937_64 keysEngine(keysSeed);
+		for(vector<uint64_t> & keys : zobristKeys)
+		{
+			keys.resize(board.GetCellsCount());
+			for(uint64_t & key : keys)
+				key = keysEngine();
+		}
+		circleToMoveKey = keysEngine();
+		zobristSeed = keysSeed;
+	}
+	hash = 0;
+	for(int cell = 0; cell < board.GetCellsCount(); cell++)
+		if(board.Get(cell) != FG_None)
+			hash ^= zobristKeys[board.Get(cell) == FG_Cross ? 0 : 1][cell];
+
+	const int runLength = board.GetRunLength();
+	runWeights.resize(runLength + 1);
+	runWeights[0] = 0;
+	for(int glyphs = 1; glyphs <= runLength; glyphs++)
+		runWeights[glyphs] = 1 << min((glyphs - 1) * RUN_WEIGHT_SHIFT, RUN_WEIGHT_MAX_SHIFT);
+}
+
+int IterativeDeepeningSearcher::Evaluate() const
+{
+	//	Sum of all the runs on the board, for cross, each one counted from its first cell
+	const int runLength = board.GetRunLength();
+	int evaluation = 0;
+	for(int cell = 0; cell < board.GetCellsCount(); cell++)
+		for(int direction = 0; direction < Board::DirectionsCount; direction++)
+		{
+			const int rowStep = Board::Directions[direction][0];
+			const int colStep = Board::Directions[direction][1];
+			const int row = board.GetRow(cell);
+			const int col = board.GetColumn(cell);
+			if(!board.IsInside(row + (runLength - 1) * rowStep, col + (runLength - 1) * colStep))
+				continue;
+
+			int crosses = 0;
+			int circles = 0;
+			for(int c = 0; c < runLength; c++)
+			{
+				const FactionGlyph runGlyph = board.Get(row + c * rowStep, col + c * colStep);
+				crosses += runGlyph == FG_Cross;
+				circles += runGlyph == FG_Circle;
+			}
+			evaluation += GetRunScore(crosses, circles);
+		}
+
+	return evaluation;
+}
+
+int IterativeDeepeningSearcher::EvaluateMove(int move, FactionGlyph glyph) const
+{
+	/*
+	 * Only the runs through the cell change: for each line, the
+	 * run is slid along the cells within reach, from the first
+	 * one fitting the board to the last one, adding the cell
+	 * entering it and dropping the one leaving it, so each cell
+	 * is read once per line.
+	 */
+	const int runLength = board.GetRunLength();
+	const int row = board.GetRow(move);
+	const int col = board.GetColumn(move);
+	int delta = 0;
+	for(int direction = 0; direction < Board::DirectionsCount; direction++)
+	{
+		const int rowStep = Board::Directions[direction][0];
+		const int colStep = Board::Directions[direction][1];
+
+		//	Reach of the line on either side of the cell, within the board
+		int backward = 0;
+		while(backward < runLength - 1 && board.IsInside(row - (backward + 1) * rowStep, col - (backward + 1) * colStep))
+			backward++;
+		int forward = 0;
+		while(forward < runLength - 1 && board.IsInside(row + (forward + 1) * rowStep, col + (forward + 1) * colStep))
+			forward++;
+		if(backward + forward + 1 < runLength)
+			continue;
+
+		int crosses = 0;
+		int circles = 0;
+		for(int offset = -backward; offset <= forward; offset++)
+		{
+			//	Cell entering the run
+			const FactionGlyph entering = board.Get(row + offset * rowStep, col + offset * colStep);
+			crosses += entering == FG_Cross;
+			circles += entering == FG_Circle;
+
+			const int first = offset - (runLength - 1);
+			if(first < -backward)
+				continue;
+
+			delta += glyph == FG_Cross ?
+				GetRunScore(crosses + 1, circles) - GetRunScore(crosses, circles) :
+				GetRunScore(crosses, circles + 1) - GetRunScore(crosses, circles);
+
+			//	Cell leaving the run
+			const FactionGlyph leaving = board.Get(row + first * rowStep, col + first * colStep);
+			crosses -= leaving == FG_Cross;
+			circles -= leaving == FG_Circle;
+		}
+	}
+
+	return delta;
+}
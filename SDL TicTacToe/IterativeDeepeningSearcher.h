@@ -0,0 +1,169 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "ThreadPool.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "Board.h"
+#include "SharedTranspositionTable.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * How long an iterative deepening search may take for a move,
+ * and what it may take to do it.
+ */
+struct DeepeningSettings
+{
+	int timeBudgetMillis = 1000;	//	Hard deadline per move, the move is always there by then (in nodes on virtual time)
+	int maxDepth = 0;	//	Stops deepening at this many plies, zero or less for no limit but the end of the game
+	int threadsCount = 1;	//	Zero or less for one per hardware thread
+	int tableMegabytes = 16;	//	Transposition table shared by the threads, zero for none
+	int virtualNodesPerMilli = 300;	//	Nodes worth a millisecond of the budget on virtual time, about what a core searches
+};
+
+/*
+ * Outcome of a search: the move to make (-1 when there's none,
+ * the game is over), its score for the faction to move (from
+ * the last completed depth, a forced win or loss if IsDecisive)
+ * and telemetry about the work it took: the deepest search
+ * completed, nodes searched and time used.
+ */
+struct DeepeningResult
+{
+	int bestMove = -1;
+	int score = 0;
+	int depthReached = 0;
+	unsigned long long nodesSearched = 0;
+	double elapsedSeconds = 0.0;
+	__inline double GetNodesPerSecond() const { return elapsedSeconds > 0.0 ? nodesSearched / elapsedSeconds : 0.0; }
+};
+
+/*
+ * Alpha-beta search for boards of any size, deepening one ply at
+ * a time until its time budget runs out: each depth completed
+ * gives a move that can be trusted, the one being searched when
+ * the deadline hits is thrown away, so the search answers on time
+ * whatever the board and the hardware, with the best move of the
+ * deepest search it could afford. The best move of each depth is
+ * tried first by the next one, which then prunes the most.
+ * The deadline is checked every few hundred nodes, reading the
+ * clock at every node would cost more than the node itself.
+ *
+ * Positions at the horizon are scored by their lines: every run
+ * of cells long enough to win, holding glyphs of one faction
+ * only, is worth more the more glyphs it holds, for that faction.
+ * The score is kept up to date move by move, as a move only
+ * changes the runs through its own cell.
+ * Only cells close to the glyphs already on the board are tried,
+ * the others can hardly matter, and they're tried in order of
+ * how much they change the score for either faction (attacks and
+ * blocks first). A winning move ends the search of its position
+ * right away. Wins are worth more the sooner they come.
+ *
+ * Positions already searched, through another order of the same
+ * moves, by an earlier depth or by an earlier move of the game,
+ * are looked up in a transposition table by their Zobrist hash:
+ * their score ends the search right away when it was searched
+ * deep enough, otherwise their best move is tried first.
+ *
+ * With more than one thread, the search is a Lazy SMP: helper
+ * searchers, one per extra thread, search the same position at
+ * the same time as this one, each with its own board, sharing
+ * nothing but the transposition table. They fill it for each
+ * other, so the main search finds ever more of its positions
+ * there. Helpers are kept from all searching the same moves at
+ * the same time by trying the moves of the position in another
+ * order, and every other helper a depth ahead. The move comes
+ * from the deepest search completed, by any of them, and the
+ * helpers stop as soon as the main search is over.
+ *
+ * Like the other searchers, it never touches the game field, it
+ * works on a copy of the board, and it can be called off through
+ * a cancellation flag, checked along with the deadline. The
+ * table, and the threads, are only made by the first search.
+ *
+ * On virtual time (e.g. headless simulations, replays) the time
+ * budget is counted in nodes instead, at a fixed rate, and the
+ * helpers are left out: how far the search goes, and so the move
+ * it finds, must not depend on the machine or on its load, or
+ * the same seed wouldn't play the same games.
+ */
+class IterativeDeepeningSearcher
+{
+	// Fields
+public:
+	static const int WinScore = 1 << 30;
+protected:
+private:
+	struct ScoredMove
+	{
+		int move;
+		int order;	//	The higher the sooner it's tried
+		int evaluationDelta;	//	Change of the score for cross, made by the move
+	};
+	DeepeningSettings settings;
+	unique_ptr<SharedTranspositionTable> ownTable;
+	SharedTranspositionTable * table = nullptr;	//	Own, or the main searcher's for helpers
+	unique_ptr<ThreadPool> pool;
+	vector<unique_ptr<IterativeDeepeningSearcher>> helpers;
+	Board board;
+	vector<uint64_t> zobristKeys[2];	//	By faction and cell
+	uint64_t circleToMoveKey = 0;
+	uint64_t zobristSeed = 0;	//	Keys are drawn again when the rules change
+	uint64_t hash = 0;
+	vector<int> neighbours;	//	Glyphs close to each cell
+	vector<int> runWeights;	//	Worth of a run by the glyphs it holds
+	vector<vector<ScoredMove>> movesByPly;
+	steady_clock::time_point deadline;
+	unsigned long long nodesBudget = 0;	//	On virtual time only, the deadline is left alone
+	const atomic<bool> * cancelled = nullptr;
+	const atomic<bool> * stopped = nullptr;	//	Set by the main searcher for its helpers
+	unsigned long long nodesSearched = 0;
+	bool aborted = false;
+	// Constructors
+public:
+	IterativeDeepeningSearcher(const DeepeningSettings & settings = DeepeningSettings());
+protected:
+private:
+	// Methods
+public:
+	DeepeningResult Search(const Board & board, FactionGlyph glyph, const atomic<bool> * cancelled = nullptr, bool virtualTime = false);
+	//	Forgets all the positions searched so far, e.g. to time searches from scratch
+	void ClearTable();
+	__inline const DeepeningSettings & GetSettings() const { return settings; }
+	__inline static bool IsDecisive(int score) { return score > WinScore / 2 || score < -WinScore / 2; }
+protected:
+private:
+	void Prepare();
+	DeepeningResult SearchRoot(const Board & searchedBoard, FactionGlyph glyph, int helper);
+	int Negamax(int depth, int ply, int alpha, int beta, FactionGlyph glyph, int evaluation);
+	int GenerateMoves(int ply, FactionGlyph glyph);
+	void MakeMove(int move, FactionGlyph glyph);
+	void UndoMove(int move);
+	void CountNeighbours(int move, int change);
+	void PrepareBoard(const Board & searchedBoard);
+	int Evaluate() const;
+	int EvaluateMove(int move, FactionGlyph glyph) const;
+	__inline int GetRunScore(int crosses, int circles) const { return circles == 0 ? runWeights[crosses] : crosses == 0 ? -runWeights[circles] : 0; }
+	__inline uint64_t GetPositionHash(FactionGlyph glyph) const { return glyph == FG_Circle ? hash ^ circleToMoveKey : hash; }
+	__inline bool IsTimeUp() const
+	{
+		return
+			(nodesBudget > 0 ? nodesSearched >= nodesBudget : steady_clock::now() >= deadline) ||
+			(cancelled && cancelled->load(memory_order_relaxed)) ||
+			(stopped && stopped->load(memory_order_relaxed));
+	}
+};
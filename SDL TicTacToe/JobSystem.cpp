@@ -0,0 +1,72 @@
+#include "JobSystem.h"
+
+#pragma region SDL Includes
+#include <SDL.h>
+#pragma endregion
+
+JobSystem::~JobSystem()
+{
+#ifndef __EMSCRIPTEN__
+	if(!worker.joinable())
+		return;
+
+	//	Jobs already queued are still run, somebody may be waiting for them
+	{
+		lock_guard<mutex> lock(queueMutex);
+		stopping = true;
+	}
+	jobAvailable.notify_one();
+	worker.join();
+#endif
+}
+
+void JobSystem::Submit(function<void()> job)
+{
+#ifdef __EMSCRIPTEN__
+	job();
+#else
+	if(inlineJobs)
+	{
+		job();
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(queueMutex);
+		jobs.push_back(move(job));
+		if(!worker.joinable())
+			worker = thread(&JobSystem::WorkerLoop, this);
+	}
+	jobAvailable.notify_one();
+#endif
+}
+
+#ifndef __EMSCRIPTEN__
+void JobSystem::WorkerLoop()
+{
+	while(true)
+	{
+		function<void()> job;
+		{
+			unique_lock<mutex> lock(queueMutex);
+			jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+			if(jobs.empty())
+				return;
+
+			job = move(jobs.front());
+			jobs.pop_front();
+		}
+
+		job();
+
+		//	Wake up the main loop, in case it's asleep until the next event (SDL event queue is thread-safe)
+		if(SDL_WasInit(SDL_INIT_EVENTS))
+		{
+			SDL_Event jobDone;
+			SDL_zero(jobDone);
+			jobDone.type = SDL_USEREVENT;
+			SDL_PushEvent(&jobDone);
+		}
+	}
+}
+#endif
@@ -0,0 +1,173 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <atomic>
+#include <functional>
+#ifndef __EMSCRIPTEN__
+#include <deque>
+#include <memory>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+#pragma endregion
+
+#pragma region Engine Includes
+#include "Random.h"
+#include "RandomEngine.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Centralized (singleton) background jobs queue, for work that
+ * would stall a frame if done inside it (e.g. a CPU searching
+ * for its move): jobs run one after another, in the order they
+ * were submitted, on a worker thread of the queue, started the
+ * first time there's a job for it.
+ * A finished job pushes an SDL user event, so a main loop asleep
+ * waiting for events wakes up and picks up the result.
+ *
+ * There's one queue per thread, like the clock, and it can run
+ * its jobs inline, right when they're submitted: threads with
+ * a virtual clock (e.g. headless simulations) have no frames to
+ * keep going and would rather not pay for the hand-off.
+ * Web builds have no threads, there jobs always run inline.
+ */
+class JobSystem
+{
+	// Fields
+public:
+protected:
+private:
+	bool inlineJobs = false;
+#ifndef __EMSCRIPTEN__
+	thread worker;
+	mutex queueMutex;
+	condition_variable jobAvailable;
+	deque<function<void()>> jobs;
+	bool stopping = false;
+#endif
+	// Constructors
+public:
+	~JobSystem();
+	// Delete copy constructor and assignment operator (singleton protection)
+	JobSystem(const JobSystem &) = delete;
+	JobSystem & operator=(const JobSystem &) = delete;
+protected:
+private:
+	JobSystem() { }
+	// Methods
+public:
+	static JobSystem & Get()
+	{
+		//	Singleton implementation (one instance per thread)
+		thread_local JobSystem instance;
+		return instance;
+	}
+
+	void Submit(function<void()> job);
+
+	__inline void SetInline(bool runInline) { inlineJobs = runInline; }
+#ifdef __EMSCRIPTEN__
+	__inline bool IsInline() const { return true; }
+#else
+	__inline bool IsInline() const { return inlineJobs; }
+#endif
+protected:
+private:
+#ifndef __EMSCRIPTEN__
+	void WorkerLoop();
+#endif
+};
+
+/*
+ * Handle to a job computing a result in the background, to be
+ * polled once per frame until it's ready, without ever waiting.
+ * The job is handed a cancellation flag, set when the result
+ * isn't wanted anymore: long jobs should check it and give up
+ * early, as cancelling waits for the job to be over, so nothing
+ * the job reads can go away under its feet.
+ *
+ * The job draws random numbers from an engine spawned from the
+ * starting thread's, in the order jobs are started, so results
+ * only depend on the seed, whichever thread computes them and
+ * whether it's computed inline or not.
+ */
+template<typename ResultType>
+class AsyncTask
+{
+private:
+	atomic<bool> cancelled{false};
+	bool inlineDone = false;	//	Jobs run inline need no future, their result is kept here
+	ResultType inlineResult;
+#ifndef __EMSCRIPTEN__
+	future<ResultType> result;
+#endif
+public:
+	AsyncTask() { }
+	~AsyncTask() { Cancel(); }
+	//	Jobs keep a reference to the cancellation flag, no copies
+	AsyncTask(const AsyncTask &) = delete;
+	AsyncTask & operator=(const AsyncTask &) = delete;
+
+	void Start(function<ResultType(const atomic<bool> & cancelled)> job)
+	{
+		Cancel();
+		cancelled = false;
+
+		const RandomEngine engine = Random::Spawn();
+		const atomic<bool> & jobCancelled = cancelled;
+		const auto work = [job, engine, &jobCancelled]()
+		{
+			const RandomEngine previousEngine = Random::SwapEngine(engine);
+			const ResultType jobResult = job(jobCancelled);
+			Random::SwapEngine(previousEngine);
+			return jobResult;
+		};
+
+		if(JobSystem::Get().IsInline())
+		{
+			inlineResult = work();
+			inlineDone = true;
+			return;
+		}
+
+#ifndef __EMSCRIPTEN__
+		const shared_ptr<packaged_task<ResultType()>> task = make_shared<packaged_task<ResultType()>>(work);
+		result = task->get_future();
+		JobSystem::Get().Submit([task]() { (*task)(); });
+#endif
+	}
+#ifdef __EMSCRIPTEN__
+	__inline bool IsRunning() const { return inlineDone; }
+	__inline bool IsReady() const { return inlineDone; }
+#else
+	__inline bool IsRunning() const { return inlineDone || result.valid(); }
+	__inline bool IsReady() const { return inlineDone || (result.valid() && result.wait_for(chrono::seconds(0)) == future_status::ready); }
+#endif
+	//	Only once ready, the task isn't running anymore afterwards
+	ResultType Get()
+	{
+#ifndef __EMSCRIPTEN__
+		if(!inlineDone)
+			return result.get();
+#endif
+		inlineDone = false;
+		return inlineResult;
+	}
+	void Cancel()
+	{
+		inlineDone = false;
+#ifndef __EMSCRIPTEN__
+		if(!result.valid())
+			return;
+
+		cancelled = true;
+		result.wait();
+		result = future<ResultType>();
+#endif
+	}
+};
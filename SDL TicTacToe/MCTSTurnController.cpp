@@ -0,0 +1,48 @@
+#include "MCTSTurnController.h"
+
+#pragma region C++ Includes
+#include <cassert>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "Clock.h"
+#pragma endregion
+
+MCTSSettings MCTSTurnController::defaultSettings;
+
+MCTSTurnController::MCTSTurnController(Field & gameField, FactionGlyph factionGlyph, const MCTSSettings & settings) :
+	ATurnController(factionGlyph),
+	gameField(gameField),
+	search(settings)
+{
+}
+
+void MCTSTurnController::TurnUpdateOperations()
+{
+	//	Think for the whole time budget, starting on the first update (see CPUTurnController)
+	if(!thinking.IsRunning())
+	{
+		//	Read here, the thinking may run on a thread of its own, with a clock of its own
+		const bool virtualTime = Clock::Get().IsVirtualClock();
+		thinking.Start([this, virtualTime](const atomic<bool> & cancelled) { return search.Search(gameField.GetBoard(), GetFactionGlyph(), &cancelled, virtualTime); });
+	}
+
+	//	Still thinking, check again next update
+	if(!thinking.IsReady())
+		return;
+
+	lastSearch = thinking.Get();
+	assert(lastSearch.bestMove > -1);	//	Shouldn't ever happen, turns are not given on a finished game
+
+	//	Perform move
+	gameField.MakeMove(lastSearch.bestMove, GetFactionGlyph());
+
+	//	Conclude turn
+	Conclude();
+}
+
+void MCTSTurnController::TurnClosingOperations()
+{
+	//	Turns close early when the game starts over, the search isn't wanted anymore
+	thinking.Cancel();
+}
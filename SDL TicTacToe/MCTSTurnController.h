@@ -0,0 +1,56 @@
+#pragma once
+
+#pragma region Engine Includes
+#include "JobSystem.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "ATurnController.h"
+#include "Field.h"
+#include "MonteCarloTreeSearch.h"
+#pragma endregion
+
+/*
+ * Controller playing with a Monte Carlo tree search, meant for
+ * the bigger boards, where the CPU controller's heuristics are
+ * easily fooled and perfect play is unknown.
+ * It takes as long as its search's time budget to move: there's
+ * no fake "thinking..." delay here, the time is spent actually
+ * thinking, in the background, so frames go on in the meantime.
+ * Starting over calls the search off. How strong it plays
+ * depends on the time budget and on the threads the search runs
+ * on, given by the settings in place when the controller is
+ * created.
+ * The playouts the last move took are kept, so the speed of the
+ * search can be compared on different machines.
+ */
+class MCTSTurnController : public ATurnController
+{
+	// Fields
+public:
+protected:
+private:
+	static MCTSSettings defaultSettings;
+	Field & gameField;
+	MonteCarloTreeSearch search;
+	MCTSResult lastSearch;
+	AsyncTask<MCTSResult> thinking;	//	Declared after the search, so it's called off before the search goes away
+	// Constructors
+public:
+	MCTSTurnController(Field & gameField, FactionGlyph factionGlyph, const MCTSSettings & settings = defaultSettings);
+protected:
+private:
+	// Methods
+public:
+	//	Settings for the controllers created from now on
+	__inline static void SetDefaultSettings(const MCTSSettings & settings) { defaultSettings = settings; }
+	__inline static const MCTSSettings & GetDefaultSettings() { return defaultSettings; }
+	//	Telemetry of the last move searched, only while not thinking
+	__inline const MCTSResult & GetLastSearch() const { return lastSearch; }
+protected:
+private:
+	//	ATurnController implementation
+	void TurnOpeningOperations() { }
+	void TurnUpdateOperations();
+	void TurnClosingOperations();
+};
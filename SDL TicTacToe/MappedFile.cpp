@@ -0,0 +1,164 @@
+#include "MappedFile.h"
+
+#pragma region Platform Includes
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#pragma endregion
+
+#pragma region Platform Definitions
+#ifdef _WIN32
+#define INVALID_FILE ((intptr_t)INVALID_HANDLE_VALUE)
+#else
+#define INVALID_FILE ((intptr_t)-1)
+#endif
+#pragma endregion
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile && other) :
+	data(other.data),
+	size(other.size),
+	fileHandle(other.fileHandle),
+	mappingHandle(other.mappingHandle)
+{
+	other.data = nullptr;
+	other.size = 0;
+	other.fileHandle = INVALID_FILE;
+	other.mappingHandle = 0;
+}
+
+MappedFile & MappedFile::operator=(MappedFile && other)
+{
+	if(this != &other)
+	{
+		Close();
+		data = other.data;
+		size = other.size;
+		fileHandle = other.fileHandle;
+		mappingHandle = other.mappingHandle;
+		other.data = nullptr;
+		other.size = 0;
+		other.fileHandle = INVALID_FILE;
+		other.mappingHandle = 0;
+	}
+
+	return *this;
+}
+
+bool MappedFile::OpenRead(const string & path)
+{
+	Close();
+
+#ifdef _WIN32
+	fileHandle = (intptr_t)CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER fileSize;
+	if(fileHandle == INVALID_FILE || !GetFileSizeEx((HANDLE)fileHandle, &fileSize))
+	{
+		Close();
+		return false;
+	}
+	size = (size_t)fileSize.QuadPart;
+#else
+	fileHandle = (intptr_t)open(path.c_str(), O_RDONLY);
+	struct stat fileStat;
+	if(fileHandle == INVALID_FILE || fstat((int)fileHandle, &fileStat) != 0)
+	{
+		Close();
+		return false;
+	}
+	size = (size_t)fileStat.st_size;
+#endif
+
+	return Map(false);
+}
+
+bool MappedFile::Create(const string & path, size_t fileSize)
+{
+	Close();
+	size = fileSize;
+
+	//	The file is sized up front, unwritten parts don't take disk space where the file system allows it
+#ifdef _WIN32
+	fileHandle = (intptr_t)CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER distance;
+	distance.QuadPart = (LONGLONG)fileSize;
+	if(
+		fileHandle == INVALID_FILE ||
+		!SetFilePointerEx((HANDLE)fileHandle, distance, nullptr, FILE_BEGIN) ||
+		!SetEndOfFile((HANDLE)fileHandle)
+	)
+	{
+		Close();
+		return false;
+	}
+#else
+	fileHandle = (intptr_t)open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(fileHandle == INVALID_FILE || ftruncate((int)fileHandle, (off_t)fileSize) != 0)
+	{
+		Close();
+		return false;
+	}
+#endif
+
+	return Map(true);
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if(data)
+		UnmapViewOfFile(data);
+	if(mappingHandle)
+		CloseHandle((HANDLE)mappingHandle);
+	if(fileHandle != INVALID_FILE)
+		CloseHandle((HANDLE)fileHandle);
+#else
+	if(data)
+		munmap(data, size);
+	if(fileHandle != INVALID_FILE)
+		close((int)fileHandle);
+#endif
+
+	data = nullptr;
+	size = 0;
+	fileHandle = INVALID_FILE;
+	mappingHandle = 0;
+}
+
+bool MappedFile::Map(bool writable)
+{
+	//	Empty files can't be mapped
+	if(size == 0)
+	{
+		Close();
+		return false;
+	}
+
+#ifdef _WIN32
+	mappingHandle = (intptr_t)CreateFileMappingA((HANDLE)fileHandle, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+	if(mappingHandle)
+		data = (uint8_t *)MapViewOfFile((HANDLE)mappingHandle, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+#else
+	void * mapped = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, (int)fileHandle, 0);
+	if(mapped != MAP_FAILED)
+		data = (uint8_t *)mapped;
+#endif
+
+	if(!data)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#pragma endregion
+
+using namespace std;
+
+/*
+ * File mapped in memory: its bytes are read and written as if
+ * they were an array, and the system loads pages from disk only
+ * when they're touched. Files opened for reading are shared by
+ * every process mapping them, so a large table costs its memory
+ * once per machine, not once per process, and it's ready as
+ * soon as it's opened, with nothing to load beforehand.
+ * Files created for writing are saved as they're written, and
+ * can be larger than the available memory.
+ *
+ * The mapping goes away with the object, which can be moved but
+ * not copied.
+ */
+class MappedFile
+{
+	// Fields
+public:
+protected:
+private:
+	uint8_t * data = nullptr;
+	size_t size = 0;
+	intptr_t fileHandle = -1;
+	intptr_t mappingHandle = 0;	//	Windows only, the mapping is a handle of its own
+	// Constructors
+public:
+	MappedFile() { }
+	~MappedFile();
+	MappedFile(MappedFile && other);
+	MappedFile & operator=(MappedFile && other);
+	MappedFile(const MappedFile &) = delete;
+	MappedFile & operator=(const MappedFile &) = delete;
+protected:
+private:
+	// Methods
+public:
+	bool OpenRead(const string & path);
+	//	Replaces the file if it exists, all of its bytes start at zero
+	bool Create(const string & path, size_t fileSize);
+	void Close();
+
+	__inline bool IsOpen() const { return data != nullptr; }
+	__inline const uint8_t * GetData() const { return data; }
+	//	Only for files created for writing
+	__inline uint8_t * GetWritableData() { return data; }
+	__inline size_t GetSize() const { return size; }
+protected:
+private:
+	bool Map(bool writable);
+};
@@ -0,0 +1,241 @@
+#include "MonteCarloTreeSearch.h"
+
+#pragma region C++ Includes
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "Random.h"
+#pragma endregion
+
+MonteCarloTreeSearch::MonteCarloTreeSearch(const MCTSSettings & settings) :
+	settings(settings),
+	pool(settings.threadsCount),
+	nodes(new Node[max(settings.nodesCapacity, 1)]),
+	nodesCount(0),
+	treeFull(false)
+{
+	this->settings.nodesCapacity = max(settings.nodesCapacity, 1);
+}
+
+MCTSResult MonteCarloTreeSearch::Search(const Board & board, FactionGlyph glyph, const atomic<bool> * cancelled, bool virtualTime)
+{
+	MCTSResult result;
+	if(board.IsGameOver())
+		return result;
+
+	//	Nothing to think about
+	if(board.GetEmptyCells().size() == 1)
+	{
+		result.bestMove = board.GetEmptyCells()[0];
+		return result;
+	}
+
+	//	On virtual time the playouts are the budget, the clock is never looked at
+	const steady_clock::time_point start = steady_clock::now();
+	const steady_clock::time_point deadline = virtualTime ? steady_clock::time_point::max() : start + milliseconds(settings.timeBudgetMillis);
+	unsigned long long maxPlayouts = settings.maxPlayouts > 0 ? (unsigned long long)settings.maxPlayouts : 0;
+	if(virtualTime)
+	{
+		const unsigned long long playoutsBudget = max(1ull, (unsigned long long)max(settings.timeBudgetMillis, 0) * max(settings.virtualPlayoutsPerMilli, 1));
+		maxPlayouts = maxPlayouts > 0 ? min(maxPlayouts, playoutsBudget) : playoutsBudget;
+	}
+
+	//	Start from a tree with just the root, which is expanded right away
+	nodesCount = 1;
+	treeFull = false;
+	ResetNode(0, board.GetLastMove());
+	Expand(0, board);
+
+	//	Each worker gets its own engine, forked in order, so the streams depend on the seed only
+	result.threadsCount = virtualTime ? 1 : pool.GetWorkersCount();
+	vector<RandomEngine> engines;
+	engines.reserve(result.threadsCount);
+	for(int worker = 0; worker < result.threadsCount; worker++)
+		engines.push_back(Random::Fork());
+
+	atomic<unsigned long long> playouts(0);
+	if(virtualTime)
+		RunPlayouts(board, glyph, engines[0], deadline, maxPlayouts, cancelled, playouts);
+	else
+		pool.Run([&](int worker) { RunPlayouts(board, glyph, engines[worker], deadline, maxPlayouts, cancelled, playouts); });
+
+	//	The most tried move is the one the search trusts the most
+	const Node & root = nodes[0];
+	const int firstChild = root.firstChild.load();
+	int bestVisits = -1;
+	for(int child = firstChild; child < firstChild + root.childrenCount; child++)
+	{
+		const int visits = nodes[child].visits.load();
+		if(visits > bestVisits)
+		{
+			bestVisits = visits;
+			result.bestMove = nodes[child].move;
+			result.expectedScore = visits > 0 ? nodes[child].halfPoints.load() / (2.0f * visits) : 0.0f;
+		}
+	}
+
+	result.playouts = playouts.load();
+	result.elapsedSeconds = duration<double>(steady_clock::now() - start).count();
+	return result;
+}
+
+void MonteCarloTreeSearch::RunPlayouts(const Board & board, FactionGlyph glyph, RandomEngine & engine, steady_clock::time_point deadline, unsigned long long maxPlayouts, const atomic<bool> * cancelled, atomic<unsigned long long> & playouts)
+{
+	//	Allocated once per search, reused by every playout
+	Board scratchBoard = board;
+	vector<int> path;
+	path.reserve(board.GetEmptyCells().size() + 1);
+
+	const FactionGlyph opponentGlyph = GetOpponentGlyph(glyph);
+	while(steady_clock::now() < deadline && !(cancelled && cancelled->load(memory_order_relaxed)))
+	{
+		//	Claim a playout, if they're limited
+		if(maxPlayouts > 0 && playouts.fetch_add(1) >= maxPlayouts)
+		{
+			playouts--;
+			break;
+		}
+
+		scratchBoard = board;
+		path.clear();
+		path.push_back(0);
+
+		/*
+		 * Selection: walk down the tree, marking the way with
+		 * virtual losses, until a leaf or the end of the game.
+		 * A leaf that has been visited already is expanded,
+		 * unless somebody else is doing it, and the walk goes
+		 * on through one of its new children.
+		 */
+		int node = 0;
+		FactionGlyph glyphToMove = glyph;
+		while(!scratchBoard.IsGameOver())
+		{
+			int firstChild = nodes[node].firstChild.load(memory_order_acquire);
+			if(firstChild < 0)
+			{
+				if(firstChild == Expanding || nodes[node].visits.load() == 0 || !Expand(node, scratchBoard))
+					break;
+				firstChild = nodes[node].firstChild.load(memory_order_acquire);
+			}
+
+			node = SelectChild(node);
+			nodes[node].virtualLosses++;
+			scratchBoard.MakeMove(nodes[node].move, glyphToMove);
+			glyphToMove = GetOpponentGlyph(glyphToMove);
+			path.push_back(node);
+		}
+
+		//	Simulation: play the rest of the game at random
+		const FactionGlyph winner = scratchBoard.IsGameOver() ? scratchBoard.GetWinner() : Playout(scratchBoard, glyphToMove, engine);
+
+		/*
+		 * Backpropagation: each node scores for the faction that
+		 * moved into it, the root for the faction that moved last
+		 * on the searched board, its children for the faction to
+		 * move and so on, alternating.
+		 */
+		for(size_t depth = 0; depth < path.size(); depth++)
+		{
+			Node & pathNode = nodes[path[depth]];
+			const FactionGlyph mover = depth % 2 == 1 ? glyph : opponentGlyph;
+			pathNode.visits++;
+			if(depth > 0)
+				pathNode.virtualLosses--;
+			if(winner == mover)
+				pathNode.halfPoints += 2;
+			else if(winner == FG_None)
+				pathNode.halfPoints += 1;
+		}
+
+		if(maxPlayouts == 0)
+			playouts++;
+	}
+}
+
+int MonteCarloTreeSearch::SelectChild(int parent) const
+{
+	/*
+	 * UCT: the average score of the child plus an exploration
+	 * bonus that grows while the parent is visited and the child
+	 * isn't. Virtual losses count as visits that scored nothing.
+	 * Children never tried come first.
+	 */
+	const Node & parentNode = nodes[parent];
+	const int firstChild = parentNode.firstChild.load(memory_order_acquire);
+	const float logParentVisits = log((float)max(parentNode.visits.load() + parentNode.virtualLosses.load(), 1));
+
+	int bestChild = firstChild;
+	float bestValue = -numeric_limits<float>::infinity();
+	for(int child = firstChild; child < firstChild + parentNode.childrenCount; child++)
+	{
+		const Node & childNode = nodes[child];
+		const int visits = childNode.visits.load() + childNode.virtualLosses.load();
+		if(visits == 0)
+			return child;
+
+		const float value = childNode.halfPoints.load() / (2.0f * visits) + settings.exploration * sqrt(logParentVisits / visits);
+		if(value > bestValue)
+		{
+			bestValue = value;
+			bestChild = child;
+		}
+	}
+
+	return bestChild;
+}
+
+bool MonteCarloTreeSearch::Expand(int node, const Board & board)
+{
+	//	Grab the node, or let whoever got it first do the job
+	int notExpanded = NotExpanded;
+	if(treeFull.load() || !nodes[node].firstChild.compare_exchange_strong(notExpanded, Expanding))
+		return false;
+
+	const vector<int> & emptyCells = board.GetEmptyCells();
+	const int childrenCount = (int)emptyCells.size();
+	const int firstChild = nodesCount.fetch_add(childrenCount);
+	if(firstChild + childrenCount > settings.nodesCapacity)
+	{
+		//	No room left, this node stays a leaf and so will the others
+		treeFull = true;
+		nodes[node].firstChild.store(NotExpanded);
+		return false;
+	}
+
+	for(int child = 0; child < childrenCount; child++)
+		ResetNode(firstChild + child, emptyCells[child]);
+
+	//	Children must be ready before anybody can see them
+	nodes[node].childrenCount = childrenCount;
+	nodes[node].firstChild.store(firstChild, memory_order_release);
+	return true;
+}
+
+void MonteCarloTreeSearch::ResetNode(int node, int move)
+{
+	Node & resetNode = nodes[node];
+	resetNode.move = move;
+	resetNode.childrenCount = 0;
+	resetNode.firstChild.store(NotExpanded, memory_order_relaxed);
+	resetNode.visits.store(0, memory_order_relaxed);
+	resetNode.virtualLosses.store(0, memory_order_relaxed);
+	resetNode.halfPoints.store(0, memory_order_relaxed);
+}
+
+FactionGlyph MonteCarloTreeSearch::Playout(Board & board, FactionGlyph glyphToMove, RandomEngine & engine)
+{
+	while(!board.IsGameOver())
+	{
+		//	Multiply-shift picks a cell with no division, the bias is negligible for any board size
+		const vector<int> & emptyCells = board.GetEmptyCells();
+		const int slot = (int)(((engine() >> 32) * emptyCells.size()) >> 32);
+		board.MakeMove(emptyCells[slot], glyphToMove);
+		glyphToMove = GetOpponentGlyph(glyphToMove);
+	}
+
+	return board.GetWinner();
+}
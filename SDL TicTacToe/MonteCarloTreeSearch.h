@@ -0,0 +1,125 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "ThreadPool.h"
+#include "RandomEngine.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "Board.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * How a Monte Carlo tree search spends its effort.
+ */
+struct MCTSSettings
+{
+	int timeBudgetMillis = 1000;	//	Real time per search (in playouts on virtual time)
+	int maxPlayouts = 0;	//	Stops earlier once this many playouts are done, zero or less for no limit
+	float exploration = 1.41f;	//	UCT exploration constant, sqrt(2) in theory, higher explores more
+	int threadsCount = 0;	//	Zero or less for one per hardware thread
+	int nodesCapacity = 1 << 20;	//	Once the tree is this big it stops growing, playouts go on from its leaves
+	int virtualPlayoutsPerMilli = 300;	//	Playouts worth a millisecond of the budget on virtual time, about what a core plays on a 7x7 board
+};
+
+/*
+ * Outcome of a search: the move to make (-1 when there's none,
+ * the game is over), the share of points it scored in the
+ * playouts (from 0, always lost, to 1, always won, draws are
+ * worth half) and how much work it took to find it.
+ */
+struct MCTSResult
+{
+	int bestMove = -1;
+	float expectedScore = 0.0f;
+	unsigned long long playouts = 0;
+	int threadsCount = 0;
+	double elapsedSeconds = 0.0;
+	__inline double GetPlayoutsPerSecond() const { return elapsedSeconds > 0.0 ? playouts / elapsedSeconds : 0.0; }
+};
+
+/*
+ * Monte Carlo tree search (UCT) for boards of any size, where a
+ * full minimax search is out of question: instead of exploring
+ * every line of play, it plays many games to the end with random
+ * moves (playouts) and grows a tree of statistics towards the
+ * moves that score the best, balancing exploitation of the best
+ * moves found so far with exploration of the less tried ones.
+ * The move tried the most is the best one.
+ *
+ * Like the negamax searcher, it never touches the game field,
+ * it works on a copy of the board.
+ *
+ * Playouts run on all the workers of a thread pool at once,
+ * sharing the same tree: statistics are atomic and a node is
+ * expanded by whoever gets there first. A worker walking down
+ * the tree adds a virtual loss to the nodes it passes through,
+ * taken back when it brings the result back up, so workers
+ * starting at the same time don't all follow the very same
+ * path. More workers, or more time, mean more playouts, and
+ * more playouts mean stronger moves.
+ *
+ * Nodes come from a pool allocated once, so searching doesn't
+ * allocate, and each worker draws from its own random engine,
+ * forked from the calling thread's.
+ *
+ * A search running in the background can be called off through
+ * a cancellation flag: it stops after the playouts under way,
+ * the result is whatever it found until then.
+ *
+ * On virtual time the budget is counted in playouts and they
+ * all run on the calling thread, one after the other: how the
+ * workers would interleave depends on the machine, so this is
+ * the only way for the same seed to pick the same moves.
+ */
+class MonteCarloTreeSearch
+{
+	// Fields
+public:
+protected:
+private:
+	static const int NotExpanded = -1;
+	static const int Expanding = -2;
+	struct Node
+	{
+		int move;
+		int childrenCount;
+		atomic<int> firstChild;	//	Index of the first child, children are contiguous
+		atomic<int> visits;
+		atomic<int> virtualLosses;
+		atomic<int> halfPoints;	//	For the faction that moved into this node: 2 per win, 1 per draw
+	};
+	MCTSSettings settings;
+	ThreadPool pool;
+	unique_ptr<Node[]> nodes;
+	atomic<int> nodesCount;
+	atomic<bool> treeFull;
+	// Constructors
+public:
+	MonteCarloTreeSearch(const MCTSSettings & settings = MCTSSettings());
+protected:
+private:
+	// Methods
+public:
+	MCTSResult Search(const Board & board, FactionGlyph glyph, const atomic<bool> * cancelled = nullptr, bool virtualTime = false);
+	__inline const MCTSSettings & GetSettings() const { return settings; }
+	__inline int GetThreadsCount() const { return pool.GetWorkersCount(); }
+protected:
+private:
+	void RunPlayouts(const Board & board, FactionGlyph glyph, RandomEngine & engine, steady_clock::time_point deadline, unsigned long long maxPlayouts, const atomic<bool> * cancelled, atomic<unsigned long long> & playouts);
+	int SelectChild(int parent) const;
+	bool Expand(int node, const Board & board);
+	void ResetNode(int node, int move);
+	static FactionGlyph Playout(Board & board, FactionGlyph glyphToMove, RandomEngine & engine);
+};
@@ -0,0 +1,316 @@
+#include "MoveLog.h"
+
+#pragma region C++ Includes
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <limits>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Line keys of the saved log
+#define LOG_KEY_SEED "seed"
+#define LOG_KEY_BOARD "board"
+#define LOG_KEY_CROSS "cross"
+#define LOG_KEY_CIRCLE "circle"
+#define LOG_KEY_DEEPENING "deepening"
+#define LOG_KEY_THREATS "threats"
+#define LOG_KEY_MCTS "mcts"
+#define LOG_KEY_GAME "game"
+//	Names of the settings, within their lines
+#define LOG_SETTING_TIME "time"
+#define LOG_SETTING_DEPTH "depth"
+#define LOG_SETTING_THREADS "threads"
+#define LOG_SETTING_TABLE "table"
+#define LOG_SETTING_RATE "rate"
+#define LOG_SETTING_THREES "threes"
+#define LOG_SETTING_PLAYOUTS "playouts"
+#define LOG_SETTING_EXPLORATION "exploration"
+#define LOG_SETTING_NODES "nodes"
+#pragma endregion
+
+MoveLog::MoveLog(uint64_t seed, const BoardRules & rules, ControlType crossControlType, ControlType circleControlType, const DeepeningSettings & deepeningSettings, const ThreatSettings & threatSettings, const MCTSSettings & mctsSettings) :
+	seed(seed),
+	rules(rules),
+	crossControlType(crossControlType),
+	circleControlType(circleControlType),
+	deepeningSettings(deepeningSettings),
+	threatSettings(threatSettings),
+	mctsSettings(mctsSettings),
+	games(1)
+{
+}
+
+void MoveLog::Record(int cell)
+{
+	games.back().push_back(cell);
+}
+
+void MoveLog::EndGame()
+{
+	//	Games with no moves are not worth recording, keep filling the same one
+	if(!games.back().empty())
+		games.emplace_back();
+}
+
+int MoveLog::GetGamesCount() const
+{
+	return games.back().empty() ? (int)games.size() - 1 : (int)games.size();
+}
+
+bool MoveLog::Save(const char * path) const
+{
+	ofstream file(path);
+	if(!file)
+		return false;
+
+	file << LOG_KEY_SEED << " " << seed << "\n";
+	file << LOG_KEY_BOARD << " " << rules.columns << "x" << rules.rows << "x" << rules.runLength << "\n";
+	file << LOG_KEY_CROSS << " " << GetControlTypeName(crossControlType) << "\n";
+	file << LOG_KEY_CIRCLE << " " << GetControlTypeName(circleControlType) << "\n";
+	file
+		<< LOG_KEY_DEEPENING
+		<< " " << LOG_SETTING_TIME << " " << deepeningSettings.timeBudgetMillis
+		<< " " << LOG_SETTING_DEPTH << " " << deepeningSettings.maxDepth
+		<< " " << LOG_SETTING_THREADS << " " << deepeningSettings.threadsCount
+		<< " " << LOG_SETTING_TABLE << " " << deepeningSettings.tableMegabytes
+		<< " " << LOG_SETTING_RATE << " " << deepeningSettings.virtualNodesPerMilli << "\n";
+	file
+		<< LOG_KEY_THREATS
+		<< " " << LOG_SETTING_TIME << " " << threatSettings.timeBudgetMillis
+		<< " " << LOG_SETTING_DEPTH << " " << threatSettings.maxDepth
+		<< " " << LOG_SETTING_THREES << " " << (threatSettings.threes ? 1 : 0)
+		<< " " << LOG_SETTING_RATE << " " << threatSettings.virtualNodesPerMilli << "\n";
+	//	Enough digits for the exploration constant to be read back exactly
+	file.precision(numeric_limits<float>::max_digits10);
+	file
+		<< LOG_KEY_MCTS
+		<< " " << LOG_SETTING_TIME << " " << mctsSettings.timeBudgetMillis
+		<< " " << LOG_SETTING_PLAYOUTS << " " << mctsSettings.maxPlayouts
+		<< " " << LOG_SETTING_EXPLORATION << " " << mctsSettings.exploration
+		<< " " << LOG_SETTING_THREADS << " " << mctsSettings.threadsCount
+		<< " " << LOG_SETTING_NODES << " " << mctsSettings.nodesCapacity
+		<< " " << LOG_SETTING_RATE << " " << mctsSettings.virtualPlayoutsPerMilli << "\n";
+	for(int game = 0; game < GetGamesCount(); game++)
+	{
+		file << LOG_KEY_GAME;
+		for(const int cell : games[game])
+			file << " " << cell;
+		file << "\n";
+	}
+
+	return (bool)file;
+}
+
+bool MoveLog::Load(const char * path)
+{
+	ifstream file(path);
+	if(!file)
+		return false;
+
+	/*
+	 * Parse into a new log and only replace this one if the
+	 * whole file makes sense: a broken file leaves this log
+	 * untouched.
+	 */
+	MoveLog loaded;
+	loaded.games.clear();
+	string line;
+	while(getline(file, line))
+	{
+		istringstream lineStream(line);
+		string key;
+		string value;
+		if(!(lineStream >> key))
+			continue;
+
+		if(key == LOG_KEY_SEED)
+		{
+			if(!(lineStream >> loaded.seed))
+				return false;
+		}
+		else if(key == LOG_KEY_BOARD)
+		{
+			if(!(lineStream >> value) || sscanf(value.c_str(), "%dx%dx%d", &loaded.rules.columns, &loaded.rules.rows, &loaded.rules.runLength) != 3)
+				return false;
+		}
+		else if(key == LOG_KEY_CROSS)
+		{
+			if(!(lineStream >> value) || !ParseControlType(value.c_str(), loaded.crossControlType))
+				return false;
+		}
+		else if(key == LOG_KEY_CIRCLE)
+		{
+			if(!(lineStream >> value) || !ParseControlType(value.c_str(), loaded.circleControlType))
+				return false;
+		}
+		else if(key == LOG_KEY_DEEPENING)
+		{
+			if(!ParseSettings(lineStream, loaded.deepeningSettings))
+				return false;
+		}
+		else if(key == LOG_KEY_THREATS)
+		{
+			if(!ParseSettings(lineStream, loaded.threatSettings))
+				return false;
+		}
+		else if(key == LOG_KEY_MCTS)
+		{
+			if(!ParseSettings(lineStream, loaded.mctsSettings))
+				return false;
+		}
+		else if(key == LOG_KEY_GAME)
+		{
+			vector<int> game;
+			int cell;
+			while(lineStream >> cell)
+			{
+				if(cell < 0 || cell >= loaded.rules.columns * loaded.rules.rows)
+					return false;
+				game.push_back(cell);
+			}
+			if(!lineStream.eof() || game.empty())
+				return false;
+			loaded.games.push_back(game);
+		}
+		else
+			return false;
+	}
+
+	//	Leave room for the next game, as a recording log would
+	loaded.games.emplace_back();
+
+	*this = loaded;
+	return true;
+}
+
+bool MoveLog::FindDivergence(const MoveLog & reference, const MoveLog & replay, int & game, int & move)
+{
+	for(game = 0; game < replay.GetGamesCount(); game++)
+	{
+		//	The replay played more games than the reference holds
+		if(game >= reference.GetGamesCount())
+		{
+			move = 0;
+			return true;
+		}
+
+		const vector<int> & referenceMoves = reference.GetGame(game);
+		const vector<int> & replayMoves = replay.GetGame(game);
+		for(move = 0; move < (int)referenceMoves.size() || move < (int)replayMoves.size(); move++)
+		{
+			//	The replay was stopped halfway through this game, fine as long as it matched so far
+			if(move >= (int)replayMoves.size() && replay.IsGameInProgress(game))
+				break;
+
+			if(
+				move >= (int)referenceMoves.size() ||
+				move >= (int)replayMoves.size() ||
+				referenceMoves[move] != replayMoves[move]
+			)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+const char * MoveLog::GetControlTypeName(ControlType controlType)
+{
+	switch(controlType)
+	{
+		case CT_CPU_Easy:
+			return "easy";
+		case CT_CPU:
+		case CT_CPU_Medium:
+			return "medium";
+		case CT_CPU_Hard:
+			return "hard";
+		case CT_CPU_MCTS:
+			return "mcts";
+		case CT_Human:
+		default:
+			return "human";
+	}
+}
+
+bool MoveLog::ParseControlType(const char * name, ControlType & controlType)
+{
+	const ControlType controlTypes[] = { CT_Human, CT_CPU_Easy, CT_CPU_Medium, CT_CPU_Hard, CT_CPU_MCTS };
+	for(const ControlType candidate : controlTypes)
+		if(strcmp(name, GetControlTypeName(candidate)) == 0)
+		{
+			controlType = candidate;
+			return true;
+		}
+
+	return false;
+}
+
+bool MoveLog::ParseSettings(istream & lineStream, DeepeningSettings & settings)
+{
+	string name;
+	while(lineStream >> name)
+	{
+		int * value =
+			name == LOG_SETTING_TIME ? &settings.timeBudgetMillis :
+			name == LOG_SETTING_DEPTH ? &settings.maxDepth :
+			name == LOG_SETTING_THREADS ? &settings.threadsCount :
+			name == LOG_SETTING_TABLE ? &settings.tableMegabytes :
+			name == LOG_SETTING_RATE ? &settings.virtualNodesPerMilli :
+			nullptr;
+		if(!value || !(lineStream >> *value) || *value < 0)
+			return false;
+	}
+
+	return settings.timeBudgetMillis > 0 && settings.virtualNodesPerMilli > 0;
+}
+
+bool MoveLog::ParseSettings(istream & lineStream, ThreatSettings & settings)
+{
+	string name;
+	while(lineStream >> name)
+	{
+		int threes = settings.threes ? 1 : 0;
+		int * value =
+			name == LOG_SETTING_TIME ? &settings.timeBudgetMillis :
+			name == LOG_SETTING_DEPTH ? &settings.maxDepth :
+			name == LOG_SETTING_THREES ? &threes :
+			name == LOG_SETTING_RATE ? &settings.virtualNodesPerMilli :
+			nullptr;
+		if(!value || !(lineStream >> *value) || *value < 0 || threes > 1)
+			return false;
+		settings.threes = threes == 1;
+	}
+
+	return settings.timeBudgetMillis > 0 && settings.virtualNodesPerMilli > 0;
+}
+
+bool MoveLog::ParseSettings(istream & lineStream, MCTSSettings & settings)
+{
+	string name;
+	while(lineStream >> name)
+	{
+		//	The only setting that isn't a count
+		if(name == LOG_SETTING_EXPLORATION)
+		{
+			if(!(lineStream >> settings.exploration) || settings.exploration <= 0.0f)
+				return false;
+			continue;
+		}
+
+		int * value =
+			name == LOG_SETTING_TIME ? &settings.timeBudgetMillis :
+			name == LOG_SETTING_PLAYOUTS ? &settings.maxPlayouts :
+			name == LOG_SETTING_THREADS ? &settings.threadsCount :
+			name == LOG_SETTING_NODES ? &settings.nodesCapacity :
+			name == LOG_SETTING_RATE ? &settings.virtualPlayoutsPerMilli :
+			nullptr;
+		if(!value || !(lineStream >> *value) || *value < 0)
+			return false;
+	}
+
+	return settings.timeBudgetMillis > 0 && settings.nodesCapacity > 0 && settings.virtualPlayoutsPerMilli > 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <cstdint>
+#include <istream>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "IterativeDeepeningSearcher.h"
+#include "ThreatSpaceSearcher.h"
+#include "MonteCarloTreeSearch.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Record of a session: everything needed to play its games
+ * again (the random seed, the board rules, who controls each
+ * faction and the settings of the searches) and the moves of
+ * each game, so that a replay can tell whether it made the
+ * very same moves.
+ *
+ * Games are kept as lists of cells, in the order they were
+ * played. The log is saved as plain text, one line per game,
+ * so logs from two builds can also be diffed by hand:
+ *
+ *	seed 1234
+ *	board 7x7x4
+ *	cross hard
+ *	circle mcts
+ *	deepening time 1000 depth 0 threads 1 table 16 rate 300
+ *	threats time 50 depth 16 threes 1 rate 500
+ *	mcts time 1000 playouts 0 exploration 1.40999997 threads 0 nodes 1048576 rate 300
+ *	game 24 25 17 ...
+ *	game ...
+ *
+ * Settings missing from a log are taken as the defaults.
+ */
+class MoveLog
+{
+	// Fields
+public:
+protected:
+private:
+	uint64_t seed = 0;
+	BoardRules rules;
+	ControlType crossControlType = CT_Human;
+	ControlType circleControlType = CT_Human;
+	DeepeningSettings deepeningSettings;
+	ThreatSettings threatSettings;
+	MCTSSettings mctsSettings;
+	vector<vector<int>> games;	//	The last one is the game being played, empty until its first move
+	// Constructors
+public:
+	MoveLog() : games(1) { }
+	MoveLog(uint64_t seed, const BoardRules & rules, ControlType crossControlType, ControlType circleControlType, const DeepeningSettings & deepeningSettings, const ThreatSettings & threatSettings, const MCTSSettings & mctsSettings);
+protected:
+private:
+	// Methods
+public:
+	__inline uint64_t GetSeed() const { return seed; }
+	__inline const BoardRules & GetRules() const { return rules; }
+	__inline ControlType GetCrossControlType() const { return crossControlType; }
+	__inline ControlType GetCircleControlType() const { return circleControlType; }
+	__inline const DeepeningSettings & GetDeepeningSettings() const { return deepeningSettings; }
+	__inline const ThreatSettings & GetThreatSettings() const { return threatSettings; }
+	__inline const MCTSSettings & GetMCTSSettings() const { return mctsSettings; }
+
+	void Record(int cell);
+	void EndGame();
+	int GetGamesCount() const;
+	__inline bool IsGameInProgress(int game) const { return game == (int)games.size() - 1 && !games.back().empty(); }
+	__inline const vector<int> & GetGame(int game) const { return games[game]; }
+
+	bool Save(const char * path) const;
+	bool Load(const char * path);
+
+	/*
+	 * Look for the first move where a replay differs from the
+	 * reference log. Only the games played by the replay are
+	 * compared, so a replay may stop before the reference does,
+	 * even halfway through a game (the game still in progress
+	 * only has to match the reference so far).
+	 * Returns false if no difference is found, otherwise the
+	 * game and move where the logs part (a move index equal to
+	 * the length of a game means that game ended earlier).
+	 */
+	static bool FindDivergence(const MoveLog & reference, const MoveLog & replay, int & game, int & move);
+protected:
+private:
+	static const char * GetControlTypeName(ControlType controlType);
+	static bool ParseControlType(const char * name, ControlType & controlType);
+	//	Read the rest of a settings line, name and value pairs, false if any is unknown or invalid
+	static bool ParseSettings(istream & lineStream, DeepeningSettings & settings);
+	static bool ParseSettings(istream & lineStream, ThreatSettings & settings);
+	static bool ParseSettings(istream & lineStream, MCTSSettings & settings);
+};
@@ -0,0 +1,174 @@
+#include "MoveScorer.h"
+
+#pragma region C++ Includes
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#pragma endregion
+
+#pragma region Compiler Intrinsics
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MOVE_SCORER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MOVE_SCORER_SSE2
+#endif
+#pragma endregion
+
+#pragma region Constant Parameters
+#define EMPTY_CELL_VALUE 1
+#define OWN_CELL_VALUE 2
+#define OPPONENT_CELL_VALUE -3
+#define MARGIN_CELL_FACTOR -6	//	Times the run length, a run crossing the margin sums below any run on the board
+#pragma endregion
+
+using namespace std;
+
+namespace
+{
+	/*
+	 * The widest vector of 16-bit lanes the build targets, with
+	 * the only three operations the scorer needs.
+	 */
+#if defined(MOVE_SCORER_AVX2)
+	const int LanesCount = 16;
+	typedef __m256i Lanes;
+	__inline Lanes Load(const int16_t * from) { return _mm256_loadu_si256((const __m256i *)from); }
+	__inline void Store(int16_t * to, Lanes lanes) { _mm256_storeu_si256((__m256i *)to, lanes); }
+	__inline Lanes Add(Lanes a, Lanes b) { return _mm256_add_epi16(a, b); }
+	__inline Lanes Max(Lanes a, Lanes b) { return _mm256_max_epi16(a, b); }
+#elif defined(MOVE_SCORER_SSE2)
+	const int LanesCount = 8;
+	typedef __m128i Lanes;
+	__inline Lanes Load(const int16_t * from) { return _mm_loadu_si128((const __m128i *)from); }
+	__inline void Store(int16_t * to, Lanes lanes) { _mm_storeu_si128((__m128i *)to, lanes); }
+	__inline Lanes Add(Lanes a, Lanes b) { return _mm_add_epi16(a, b); }
+	__inline Lanes Max(Lanes a, Lanes b) { return _mm_max_epi16(a, b); }
+#else
+	const int LanesCount = 1;
+	typedef int16_t Lanes;
+	__inline Lanes Load(const int16_t * from) { return *from; }
+	__inline void Store(int16_t * to, Lanes lanes) { *to = lanes; }
+	__inline Lanes Add(Lanes a, Lanes b) { return (Lanes)(a + b); }
+	__inline Lanes Max(Lanes a, Lanes b) { return a > b ? a : b; }
+#endif
+
+	__inline int RoundUpToLanes(int count)
+	{
+		return (count + LanesCount - 1) / LanesCount * LanesCount;
+	}
+}
+
+const vector<int16_t> & MoveScorer::Score(const Board & board, FactionGlyph glyph)
+{
+	assert(glyph != FG_None);
+	assert(IsSupported(board.GetRules()));
+
+	Prepare(board.GetRules());
+
+	//	Cell values, the margin keeps its own from when the grid was laid out
+	for(int row = 0; row < rows; row++)
+	{
+		int16_t * rowValues = &values[(row + padding) * paddedColumns + padding];
+		for(int col = 0; col < columns; col++)
+		{
+			const FactionGlyph cell = board.Get(row, col);
+			rowValues[col] = cell == FG_None ? EMPTY_CELL_VALUE : cell == glyph ? OWN_CELL_VALUE : OPPONENT_CELL_VALUE;
+		}
+	}
+
+	/*
+	 * Only the stretch of the grid from the first cell of the
+	 * board to the last is kept, the runs through it start up to
+	 * the margin before it: a run of the last cell going up and
+	 * back starts exactly at the beginning of the grid.
+	 */
+	const int first = padding * paddedColumns + padding;
+	const int count = RoundUpToLanes((rows - 1) * paddedColumns + columns);
+	fill(bestSums.begin() + first, bestSums.begin() + first + count, (int16_t)SHRT_MIN);
+	for(int direction = 0; direction < Board::DirectionsCount; direction++)
+	{
+		const int step = Board::Directions[direction][0] * paddedColumns + Board::Directions[direction][1];
+		SumRuns(step, first + count);
+		KeepBestRuns(step, first, count);
+	}
+
+	//	Each run counted the cell itself as empty, and only runs better than none at all count
+	const int baseScore = -(2 * runLength - 1);
+	for(int row = 0; row < rows; row++)
+	{
+		const int16_t * rowSums = &bestSums[(row + padding) * paddedColumns + padding];
+		int16_t * rowScores = &scores[row * columns];
+		for(int col = 0; col < columns; col++)
+			rowScores[col] = board.Get(row, col) != FG_None ?
+				(int16_t)baseScore :
+				(int16_t)max(baseScore, baseScore + rowSums[col] - EMPTY_CELL_VALUE);
+	}
+
+	return scores;
+}
+
+const char * MoveScorer::GetInstructionSet()
+{
+#if defined(MOVE_SCORER_AVX2)
+	return "AVX2";
+#elif defined(MOVE_SCORER_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+void MoveScorer::Prepare(const BoardRules & rules)
+{
+	/*
+	 * The grid only depends on the rules, it's laid out again
+	 * only when they change: the board with a margin one run
+	 * long all around, so no run through a cell of the board
+	 * wraps around a row, and room past the end for the last
+	 * vectors and for the runs starting there.
+	 */
+	if(rules.columns == columns && rules.rows == rows && rules.runLength == runLength)
+		return;
+
+	columns = rules.columns;
+	rows = rules.rows;
+	runLength = rules.runLength;
+	padding = runLength - 1;
+	paddedColumns = columns + 2 * padding;
+
+	const int paddedCellsCount = paddedColumns * (rows + 2 * padding) + 2 * LanesCount;
+	values.assign(paddedCellsCount + padding * (paddedColumns + 1), (int16_t)(MARGIN_CELL_FACTOR * runLength));
+	runSums.assign(paddedCellsCount, 0);
+	bestSums.assign(paddedCellsCount, 0);
+	scores.assign(columns * rows, 0);
+}
+
+void MoveScorer::SumRuns(int step, int count)
+{
+	//	The run starting at each cell of the grid, one step after the other
+	const int16_t * from = values.data();
+	int16_t * to = runSums.data();
+	for(int cell = 0; cell < count; cell += LanesCount)
+	{
+		Lanes sum = Load(from + cell);
+		for(int c = 1; c < runLength; c++)
+			sum = Add(sum, Load(from + cell + c * step));
+		Store(to + cell, sum);
+	}
+}
+
+void MoveScorer::KeepBestRuns(int step, int first, int count)
+{
+	//	The runs through each cell start up to a run before it
+	const int16_t * from = runSums.data();
+	int16_t * to = bestSums.data();
+	for(int cell = first; cell < first + count; cell += LanesCount)
+	{
+		Lanes best = Load(to + cell);
+		for(int c = 0; c < runLength; c++)
+			best = Max(best, Load(from + cell - c * step));
+		Store(to + cell, best);
+	}
+}
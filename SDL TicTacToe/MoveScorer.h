@@ -0,0 +1,68 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <cstdint>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "Board.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Scores every cell of a board at once, the way
+ * Field::GetMoveScore scores a single one: a move is worth as
+ * much as the best run of cells through it, long enough to win,
+ * each run scored by its other cells (empty cells give 1, own
+ * cells give 2, opponent's cells take 3).
+ *
+ * Rather than walking the runs of each cell, every run is
+ * summed once: the board is laid out as a grid of cell values,
+ * with a margin of cells worth so little that any run crossing
+ * it can't be the best one, so runs are summed along each
+ * direction by adding the grid to itself shifted one step at a
+ * time, and each cell takes the best of the runs through it by
+ * the same shifts, the other way around. All of it is plain
+ * adds and maxes over contiguous memory, done 16 cells at a
+ * time with AVX2, 8 with SSE2, or one at a time when neither is
+ * there (e.g. web builds), always with the same results.
+ *
+ * Buffers are kept from one call to the next, so scoring the
+ * same board size again allocates nothing: one scorer per
+ * thread.
+ */
+class MoveScorer
+{
+	// Fields
+public:
+	static const int MaxRunLength = 64;	//	Longer runs would overflow the 16-bit sums
+protected:
+private:
+	int columns = 0;
+	int rows = 0;
+	int runLength = 0;
+	int padding = 0;
+	int paddedColumns = 0;
+	vector<int16_t> values;
+	vector<int16_t> runSums;
+	vector<int16_t> bestSums;
+	vector<int16_t> scores;
+	// Constructors
+public:
+protected:
+private:
+	// Methods
+public:
+	//	Score of each cell of the board, by linear index, valid until the next call
+	const vector<int16_t> & Score(const Board & board, FactionGlyph glyph);
+	__inline static bool IsSupported(const BoardRules & rules) { return rules.runLength > 0 && rules.runLength <= MaxRunLength; }
+	static const char * GetInstructionSet();
+protected:
+private:
+	void Prepare(const BoardRules & rules);
+	void SumRuns(int step, int count);
+	void KeepBestRuns(int step, int first, int count);
+};
@@ -0,0 +1,162 @@
+#include "NegamaxSearcher.h"
+
+#pragma region C++ Includes
+#include <cassert>
+#pragma endregion
+
+/*
+ * Alpha-beta prunes the most when the best moves are tried
+ * first. In Tic-Tac-Toe the center belongs to the most combos,
+ * corners come next and edges last, so that's the order in
+ * which we try moves (after the move suggested by the
+ * transposition table, if any).
+ */
+
+const int NegamaxSearcher::movesOrder[Bitboard::CellsCount] = { 4, 0, 2, 6, 8, 1, 3, 5, 7 };
+
+SearchResult NegamaxSearcher::Search(Bitboard board, FactionGlyph glyph)
+{
+	assert(glyph != FG_None);
+
+	SearchResult result;
+	nodesSearched = 0;
+
+	//	Nothing to search if the game is already over
+	if(board.IsGameOver())
+		return result;
+
+	/*
+	 * The root is searched differently from inner nodes: we
+	 * want to know all the moves sharing the best score, so
+	 * the AI can pick randomly among them and not always
+	 * play the same game. To do so, after the first move,
+	 * the window is opened just below the best score, so
+	 * equivalent moves get an exact score while worse moves
+	 * are still pruned.
+	 */
+	const FactionGlyph opponentGlyph = GetOpponentGlyph(glyph);
+	const CellsMask emptyCells = board.GetEmpty();
+	int bestScore = -WinScore - 1;
+	for(const int move : movesOrder)
+	{
+		if(!(emptyCells & Bitboard::CellBit(move)))
+			continue;
+
+		board.Set(move, glyph);
+		const int score = Bitboard::IsWinningMask(board.GetMask(glyph)) ?
+			GetWinScore(board) :
+			-Negamax(board, opponentGlyph, -WinScore - 1, -(bestScore - 1));
+		board.Unset(move);
+
+		if(score > bestScore)
+		{
+			bestScore = score;
+			result.bestMove = move;
+			result.bestMoves = Bitboard::CellBit(move);
+		}
+		else if(score == bestScore)
+			result.bestMoves |= Bitboard::CellBit(move);
+	}
+
+	result.score = bestScore;
+	result.nodesSearched = nodesSearched;
+	return result;
+}
+
+int NegamaxSearcher::Negamax(Bitboard & board, FactionGlyph glyph, int alpha, int beta)
+{
+	nodesSearched++;
+
+	/*
+	 * Only the faction that just moved can have won, and the
+	 * caller already checks that right after making its move,
+	 * so the only terminal state left to check here is the
+	 * full board.
+	 */
+	const CellsMask emptyCells = board.GetEmpty();
+	if(!emptyCells)
+		return 0;
+
+	/*
+	 * Check whether this position, or any of its symmetric
+	 * variants, has already been searched. An exact score
+	 * ends the search here, a bound may narrow the window
+	 * enough to end it as well. In any case the stored best
+	 * move is the best candidate to be tried first.
+	 */
+	int candidateMove = -1;
+	TranspositionKey key;
+	if(useTranspositionTable)
+	{
+		key = TranspositionTable::MakeKey(board);
+
+		TranspositionEntry entry;
+		if(transpositionTable.Probe(key, entry))
+		{
+			switch(entry.bound)
+			{
+				case BoundType::Exact:
+					return entry.score;
+				case BoundType::LowerBound:
+					if(entry.score > alpha)
+						alpha = entry.score;
+					break;
+				case BoundType::UpperBound:
+					if(entry.score < beta)
+						beta = entry.score;
+					break;
+				default:
+					break;
+			}
+			if(alpha >= beta)
+				return entry.score;
+
+			candidateMove = entry.bestMove;
+		}
+	}
+
+	//	Window to compare the result against, to tell exact scores from bounds
+	const int windowAlpha = alpha;
+	const int windowBeta = beta;
+
+	const FactionGlyph opponentGlyph = GetOpponentGlyph(glyph);
+	int bestScore = -WinScore - 1;
+	int bestMove = -1;
+	for(int m = -1; m < Bitboard::CellsCount; m++)
+	{
+		//	First iteration is reserved to the candidate move, then skip it when met again
+		const int move = m < 0 ? candidateMove : movesOrder[m];
+		if(move < 0 || (m > -1 && move == candidateMove) || !(emptyCells & Bitboard::CellBit(move)))
+			continue;
+
+		board.Set(move, glyph);
+		const int score = Bitboard::IsWinningMask(board.GetMask(glyph)) ?
+			GetWinScore(board) :
+			-Negamax(board, opponentGlyph, -beta, -alpha);
+		board.Unset(move);
+
+		if(score > bestScore)
+		{
+			bestScore = score;
+			bestMove = move;
+		}
+		if(score > alpha)
+			alpha = score;
+
+		//	The opponent won't allow this line, no need to look further
+		if(alpha >= beta)
+			break;
+	}
+
+	//	Remember the result, along with how much it can be trusted
+	if(useTranspositionTable)
+	{
+		const BoundType bound =
+			bestScore <= windowAlpha ? BoundType::UpperBound :
+			bestScore >= windowBeta ? BoundType::LowerBound :
+			BoundType::Exact;
+		transpositionTable.Store(key, bestScore, bestMove, bound);
+	}
+
+	return bestScore;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "Bitboard.h"
+#include "TranspositionTable.h"
+#pragma endregion
+
+/*
+ * Outcome of a search: the score of the position from the
+ * point of view of the faction to move, all the moves that
+ * achieve that score and how much work it took to find them.
+ * A move is the linear index of a cell (row * 3 + col), -1
+ * means that there's no move to make (the game is over).
+ */
+struct SearchResult
+{
+	int score = 0;
+	int bestMove = -1;
+	CellsMask bestMoves = 0;
+	unsigned long long nodesSearched = 0;
+};
+
+/*
+ * Perfect-play search engine for Tic-Tac-Toe, based on the
+ * negamax formulation of minimax with alpha-beta pruning.
+ * The searcher never touches the game field: it receives a
+ * copy of the board and speculates on that copy, so it can
+ * be used by the AI controllers as well as by any tool that
+ * needs to analyse positions.
+ *
+ * Scores are positive when the faction to move wins, negative
+ * when it loses and zero for draws. Wins are worth more the
+ * fewer glyphs are on the board, so the engine goes for the
+ * fastest win and delays losses as much as possible.
+ * Since the score only depends on the position and not on
+ * how deep in the search it has been found, scores can be
+ * remembered in a transposition table and reused by later
+ * searches, even across turns and games.
+ */
+class NegamaxSearcher
+{
+	// Fields
+public:
+	static const int WinScore = Bitboard::CellsCount + 1;
+protected:
+private:
+	static const int movesOrder[Bitboard::CellsCount];
+	TranspositionTable transpositionTable;
+	bool useTranspositionTable = true;
+	unsigned long long nodesSearched = 0;
+	// Constructors
+public:
+protected:
+private:
+	// Methods
+public:
+	SearchResult Search(Bitboard board, FactionGlyph glyph);
+	__inline unsigned long long GetNodesSearched() const { return nodesSearched; }
+	__inline TranspositionTable & GetTranspositionTable() { return transpositionTable; }
+	__inline const TranspositionTable & GetTranspositionTable() const { return transpositionTable; }
+	__inline void SetUseTranspositionTable(bool use) { useTranspositionTable = use; }
+protected:
+private:
+	int Negamax(Bitboard & board, FactionGlyph glyph, int alpha, int beta);
+	__inline static int GetWinScore(const Bitboard & board) { return WinScore - Bitboard::CountCells(board.GetOccupied()); }
+};
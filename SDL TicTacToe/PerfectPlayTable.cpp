@@ -0,0 +1,192 @@
+#include "PerfectPlayTable.h"
+
+#pragma region Game Includes
+#include "NegamaxSearcher.h"
+#pragma endregion
+
+/*
+ * Everything in this unnamed namespace runs at compile time:
+ * the table is generated and checked by the compiler and only
+ * the resulting data ends up in the executable.
+ *
+ * Generating the table doesn't need any search: a move always
+ * adds a digit to the base-3 index of a board, so every board
+ * reachable from another one has a higher index. Walking the
+ * indices backwards means that, by the time a board is met,
+ * all the boards its moves lead to have already been solved,
+ * and solving it is just a matter of picking their best.
+ *
+ * Compilers put a limit on how much work a constant expression
+ * can take, and this one is well above the default limits:
+ * the build configuration raises them for this project.
+ */
+
+namespace
+{
+	struct PerfectPlayData
+	{
+		PerfectPlayEntry entries[Bitboard::IndicesCount];
+	};
+
+	constexpr int GetDigitWeight(int cell)
+	{
+		int weight = 1;
+		for(int c = 0; c < cell; c++)
+			weight *= 3;
+		return weight;
+	}
+
+	constexpr void DecodeIndex(int index, CellsMask & crossMask, CellsMask & circleMask)
+	{
+		crossMask = 0;
+		circleMask = 0;
+		for(int cell = 0; cell < Bitboard::CellsCount; cell++, index /= 3)
+			if(index % 3 == 1)
+				crossMask |= Bitboard::CellBit(cell);
+			else if(index % 3 == 2)
+				circleMask |= Bitboard::CellBit(cell);
+	}
+
+	constexpr PerfectPlayData GeneratePerfectPlayData()
+	{
+		PerfectPlayData data{};
+
+		for(int index = Bitboard::IndicesCount - 1; index >= 0; index--)
+		{
+			CellsMask crossMask = 0;
+			CellsMask circleMask = 0;
+			DecodeIndex(index, crossMask, circleMask);
+			const CellsMask occupiedCells = crossMask | circleMask;
+			const int glyphsCount = Bitboard::CountCells(occupiedCells);
+			PerfectPlayEntry & entry = data.entries[index];
+
+			//	Game already won, by the faction that moved last: the faction to move has lost
+			if(Bitboard::IsWinningMask(crossMask) || Bitboard::IsWinningMask(circleMask))
+			{
+				entry.score = (int8_t)-(NegamaxSearcher::WinScore - glyphsCount);
+				entry.bestMoves = 0;
+				continue;
+			}
+
+			//	Game over with a draw
+			if(occupiedCells == Bitboard::FullMask)
+			{
+				entry.score = 0;
+				entry.bestMoves = 0;
+				continue;
+			}
+
+			//	Moves lead to higher indices, all already solved: just pick the best ones
+			const bool crossToMove = Bitboard::CountCells(crossMask) == Bitboard::CountCells(circleMask);
+			const int moveDigit = crossToMove ? 1 : 2;
+			int bestScore = -NegamaxSearcher::WinScore - 1;
+			CellsMask bestMoves = 0;
+			for(int cell = 0; cell < Bitboard::CellsCount; cell++)
+			{
+				if(occupiedCells & Bitboard::CellBit(cell))
+					continue;
+
+				const int score = -data.entries[index + moveDigit * GetDigitWeight(cell)].score;
+				if(score > bestScore)
+				{
+					bestScore = score;
+					bestMoves = Bitboard::CellBit(cell);
+				}
+				else if(score == bestScore)
+					bestMoves |= Bitboard::CellBit(cell);
+			}
+			entry.score = (int8_t)bestScore;
+			entry.bestMoves = bestMoves;
+		}
+
+		return data;
+	}
+
+	/*
+	 * Plain minimax, no pruning, no memory: slow but obviously
+	 * correct, used to double check the generated table.
+	 */
+	constexpr int SolveByBruteForce(CellsMask toMoveMask, CellsMask waitingMask)
+	{
+		const CellsMask emptyCells = (CellsMask)(Bitboard::FullMask & ~(toMoveMask | waitingMask));
+		if(!emptyCells)
+			return 0;
+
+		int bestScore = -NegamaxSearcher::WinScore - 1;
+		for(int cell = 0; cell < Bitboard::CellsCount; cell++)
+		{
+			if(!(emptyCells & Bitboard::CellBit(cell)))
+				continue;
+
+			const CellsMask movedMask = toMoveMask | Bitboard::CellBit(cell);
+			const int score = Bitboard::IsWinningMask(movedMask) ?
+				NegamaxSearcher::WinScore - Bitboard::CountCells(movedMask | waitingMask) :
+				-SolveByBruteForce(waitingMask, movedMask);
+			if(score > bestScore)
+				bestScore = score;
+		}
+
+		return bestScore;
+	}
+
+	constexpr bool VerifyAgainstBruteForce(const PerfectPlayData & data, int minGlyphsCount)
+	{
+		for(int index = 0; index < Bitboard::IndicesCount; index++)
+		{
+			CellsMask crossMask = 0;
+			CellsMask circleMask = 0;
+			DecodeIndex(index, crossMask, circleMask);
+			const int crossCount = Bitboard::CountCells(crossMask);
+			const int circleCount = Bitboard::CountCells(circleMask);
+
+			//	Only check boards that can actually happen in a game, and are cheap enough to brute force
+			if(crossCount + circleCount < minGlyphsCount || (crossCount != circleCount && crossCount != circleCount + 1))
+				continue;
+			if(Bitboard::IsWinningMask(crossMask) || Bitboard::IsWinningMask(circleMask))
+				continue;
+
+			const bool crossToMove = crossCount == circleCount;
+			const CellsMask toMoveMask = crossToMove ? crossMask : circleMask;
+			const CellsMask waitingMask = crossToMove ? circleMask : crossMask;
+			const PerfectPlayEntry & entry = data.entries[index];
+
+			if(entry.score != SolveByBruteForce(toMoveMask, waitingMask))
+				return false;
+
+			//	Each move is a best move if and only if it keeps the score of the position
+			for(int cell = 0; cell < Bitboard::CellsCount; cell++)
+			{
+				if((toMoveMask | waitingMask) & Bitboard::CellBit(cell))
+					continue;
+
+				const CellsMask movedMask = toMoveMask | Bitboard::CellBit(cell);
+				const int score = Bitboard::IsWinningMask(movedMask) ?
+					NegamaxSearcher::WinScore - Bitboard::CountCells(movedMask | waitingMask) :
+					-SolveByBruteForce(waitingMask, movedMask);
+				const bool isBestMove = (entry.bestMoves & Bitboard::CellBit(cell)) != 0;
+				if(isBestMove != (score == entry.score))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	constexpr PerfectPlayData perfectPlayData = GeneratePerfectPlayData();
+
+	/*
+	 * Compile time checks: brute forcing the whole tree would take
+	 * too long for a compiler, so the table is checked against
+	 * brute force on all the positions with a few glyphs already
+	 * placed, and against well known facts about the earlier ones.
+	 */
+	static_assert(VerifyAgainstBruteForce(perfectPlayData, 4), "Perfect play table doesn't match brute force solver");
+	static_assert(perfectPlayData.entries[0].score == 0, "Tic-Tac-Toe must be a draw with perfect play");
+	static_assert(perfectPlayData.entries[0].bestMoves == Bitboard::FullMask, "Every opening move must keep the draw");
+	static_assert(perfectPlayData.entries[1 * GetDigitWeight(4)].bestMoves == 0x145, "Only corners can answer a center opening");
+}
+
+const PerfectPlayEntry & PerfectPlayTable::Lookup(BoardIndex index)
+{
+	return perfectPlayData.entries[index];
+}
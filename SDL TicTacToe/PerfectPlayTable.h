@@ -0,0 +1,41 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <cstdint>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Bitboard.h"
+#pragma endregion
+
+/*
+ * Game-theoretic value of a position and the moves that keep
+ * it. The score follows the same convention as the searcher:
+ * it's seen from the faction to move, positive when winning,
+ * negative when losing and zero when the game is a draw, and
+ * the sooner the win the higher the score.
+ * Positions where the game is over have no best moves.
+ */
+struct PerfectPlayEntry
+{
+	int8_t score;
+	CellsMask bestMoves;
+};
+
+/*
+ * Tic-Tac-Toe is small enough that the best moves for every
+ * possible board can be computed once and for all. This class
+ * exposes a table, generated at compile time, with an entry
+ * for every board index: asking for the best moves costs a
+ * single array lookup and no time at all is spent to build
+ * the table when the program starts.
+ *
+ * The faction to move is deduced from the glyphs on the board,
+ * with the cross always opening the game.
+ */
+class PerfectPlayTable
+{
+public:
+	static const PerfectPlayEntry & Lookup(BoardIndex index);
+	__inline static const PerfectPlayEntry & Lookup(const Bitboard & board) { return Lookup(board.GetIndex()); }
+};
@@ -1,23 +1,120 @@
 #include "Random.h"
 
-random_device Random::rd{};
-default_random_engine Random::engine(rd());
+#include <atomic>
+
+//	Next stream to hand out to threads that don't pick their own
+static atomic<uint64_t> nextStream{0};
 
 int Random::Range(int minInclusive, int maxExclusive)
 {
-	uniform_int_distribution<int> range(minInclusive, maxExclusive - 1);
+	/*
+	 * Lemire's nearly divisionless method: the upper half of a
+	 * 32x32 bit product maps a random number to the range, the
+	 * lower half tells whether it landed in the small biased
+	 * zone, in which case it's drawn again.
+	 */
+	const uint32_t range = (uint32_t)(maxExclusive - minInclusive);
+	uint64_t product = (GetEngine()() >> 32) * range;
+	uint32_t low = (uint32_t)product;
+	if(low < range)
+	{
+		const uint32_t threshold = (0u - range) % range;
+		while(low < threshold)
+		{
+			product = (GetEngine()() >> 32) * range;
+			low = (uint32_t)product;
+		}
+	}
 	
-	return range(engine);
+	return minInclusive + (int)(product >> 32);
 }
 float Random::RangeF(float minInclusive, float maxInclusive)
 {
-	uniform_real_distribution<float> range(minInclusive, maxInclusive);
-	
-	return range(engine);
+	return minInclusive + (maxInclusive - minInclusive) * GetUnitFloat();
 }
 bool Random::GetChance(float chance)
 {
-	uniform_real_distribution<float> range(0.0f, 1.0f);
-	
-	return range(engine) <= chance;
+	return GetUnitFloat() < chance;
+}
+
+void Random::Seed(uint64_t seed)
+{
+	RandomEngine & engine = GetEngine();
+	GetRootSeed() = seed;
+	nextStream = 0;
+	engine = CreateEngine(seed, nextStream++);
+}
+uint64_t Random::GetSeed()
+{
+	return GetRootSeed();
+}
+void Random::SeedThread(uint64_t seed, uint64_t stream)
+{
+	/*
+	 * Jumping to the stream would take as many jumps as streams
+	 * before it, a cost growing with every batch handed out: the
+	 * stream is mixed through SplitMix64 and into the seed
+	 * instead, like Spawn, far apart from any other in practice.
+	 */
+	uint64_t streamState = stream;
+	GetEngine() = RandomEngine(seed ^ RandomEngine::SplitMix64(streamState));
+}
+RandomEngine Random::Fork()
+{
+	//	The fork goes on from here, while the calling thread's engine jumps to a stream of its own
+	RandomEngine & engine = GetEngine();
+	const RandomEngine fork = engine;
+	engine.Jump();
+
+	return fork;
+}
+RandomEngine Random::Spawn()
+{
+	/*
+	 * A jump takes hundreds of steps, too many to pay for every
+	 * little job: seeding through SplitMix64 gives a stream just
+	 * as well mixed, which can't be guaranteed not to overlap
+	 * others, but won't in practice for the numbers it yields.
+	 */
+	return RandomEngine(GetEngine()());
+}
+RandomEngine Random::SwapEngine(const RandomEngine & engine)
+{
+	RandomEngine & threadEngine = GetEngine();
+	const RandomEngine previousEngine = threadEngine;
+	threadEngine = engine;
+
+	return previousEngine;
+}
+
+uint64_t & Random::GetRootSeed()
+{
+	//	Drawn once per run (unless set), thread-safe since C++11 static initialization
+	static uint64_t rootSeed = []()
+	{
+		random_device rd;
+		return ((uint64_t)rd() << 32) | rd();
+	}();
+
+	return rootSeed;
+}
+RandomEngine Random::CreateEngine(uint64_t seed, uint64_t stream)
+{
+	RandomEngine engine(seed);
+	for(uint64_t s = 0; s < stream; s++)
+		engine.Jump();
+
+	return engine;
+}
+RandomEngine & Random::GetEngine()
+{
+	//	Threads not seeded explicitly take the next free stream when they first need a number
+	thread_local RandomEngine engine = CreateEngine(GetRootSeed(), nextStream++);
+
+	return engine;
+}
+float Random::GetUnitFloat()
+{
+	//	24 random bits, as many as a float's mantissa holds, scaled to [0; 1)
+	return (float)(GetEngine()() >> 40) * (1.0f / 16777216.0f);
 }
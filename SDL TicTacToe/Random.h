@@ -1,21 +1,55 @@
 #pragma once
 
 #include <random>
+#include <cstdint>
+
+#include "RandomEngine.h"
 
 using namespace std;
 
 /*
  * Utility class for generation of random numbers
+ *
+ * Each thread draws from its own engine, so games can run in
+ * parallel without sharing (and racing on) any state. Engines
+ * are all seeded from the same root seed, then jumped to their
+ * own stream: the first thread asking for a number gets the
+ * first stream, the second one the second stream and so on,
+ * unless a thread picks its stream explicitly: then the stream
+ * is mixed into the seed, in constant time however many streams
+ * there are (e.g. one per batch of games).
+ *
+ * The root seed is random unless set with Seed(), which makes
+ * the whole run reproducible. Standard distributions are free
+ * to produce different numbers on different standard libraries,
+ * so numbers are shaped here instead: the same seed gives the
+ * same numbers with any compiler, on any platform.
  */
 class Random
 {
-	static random_device rd;
-	static default_random_engine engine;
 public:
 	//	Generate a random integer in the given range [min; max)
 	static int Range(int minInclusive, int maxExclusive);
-	//	Generate a random float in the given range [min; max]
+	//	Generate a random float in the given range [min; max)
 	static float RangeF(float minInclusive, float maxInclusive);
-	//	Generate a random number in the [0; 1] range and check it against a chance
+	//	Generate a random number in the [0; 1) range and check it against a chance
 	static bool GetChance(float chance);
+
+	//	Set the root seed and restart the calling thread from the first stream
+	static void Seed(uint64_t seed);
+	//	Root seed, set or random, to be reported so the run can be reproduced
+	static uint64_t GetSeed();
+	//	Restart the calling thread's engine from the given seed, on the given stream, without jumps
+	static void SeedThread(uint64_t seed, uint64_t stream);
+	//	Hand out an engine the calling thread won't ever overlap with, deterministically
+	static RandomEngine Fork();
+	//	Seed a new engine from a number drawn by the calling thread, cheaper than a fork for short-lived engines
+	static RandomEngine Spawn();
+	//	Make the calling thread draw from the given engine (e.g. forked for it), returns the one replaced
+	static RandomEngine SwapEngine(const RandomEngine & engine);
+private:
+	static uint64_t & GetRootSeed();
+	static RandomEngine CreateEngine(uint64_t seed, uint64_t stream);
+	static RandomEngine & GetEngine();
+	static float GetUnitFloat();
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <cstdint>
+#pragma endregion
+
+/*
+ * xoshiro256** pseudo-random generator (Blackman and Vigna).
+ * Small (four 64 bit words), fast and with good statistical
+ * quality, it satisfies the standard UniformRandomBitGenerator
+ * requirements so it can feed the standard distributions.
+ *
+ * What makes it fit for multi-threading is the jump function:
+ * it moves the state 2^128 steps ahead, so engines seeded the
+ * same way and jumped a different number of times produce
+ * sequences that never overlap. Each thread gets its own
+ * stream, no locks and no shared state involved.
+ */
+class RandomEngine
+{
+	// Fields
+public:
+	typedef uint64_t result_type;
+protected:
+private:
+	uint64_t state[4];
+	// Constructors
+public:
+	explicit RandomEngine(uint64_t seed = 0) { Seed(seed); }
+protected:
+private:
+	// Methods
+public:
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT64_MAX; }
+
+	/*
+	 * The state is filled through SplitMix64, as recommended by
+	 * the authors: any seed, even zero or a small integer, gives
+	 * a well mixed state.
+	 */
+	void Seed(uint64_t seed)
+	{
+		for(uint64_t & word : state)
+			word = SplitMix64(seed);
+	}
+
+	result_type operator()()
+	{
+		const uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+		const uint64_t t = state[1] << 17;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = RotateLeft(state[3], 45);
+
+		return result;
+	}
+
+	//	Move the state 2^128 steps ahead, to start a new non-overlapping stream
+	void Jump()
+	{
+		static const uint64_t JumpPolynomial[4] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+
+		uint64_t jumped[4] = { 0, 0, 0, 0 };
+		for(const uint64_t polynomialWord : JumpPolynomial)
+			for(int bit = 0; bit < 64; bit++)
+			{
+				if(polynomialWord & (1ull << bit))
+					for(int w = 0; w < 4; w++)
+						jumped[w] ^= state[w];
+				(*this)();
+			}
+
+		for(int w = 0; w < 4; w++)
+			state[w] = jumped[w];
+	}
+
+	//	Advances the given state and returns a well mixed value out of it
+	static uint64_t SplitMix64(uint64_t & splitMixState)
+	{
+		uint64_t z = (splitMixState += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+protected:
+private:
+	static constexpr uint64_t RotateLeft(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
@@ -0,0 +1,52 @@
+#include "RemoteTurnController.h"
+
+
+RemoteTurnController::RemoteTurnController(Field & gameField, IRemoteLink & link, FactionGlyph factionGlyph) :
+	ATurnController(factionGlyph),
+	gameField(gameField),
+	link(link)
+{ }
+
+void RemoteTurnController::TurnOpeningOperations()
+{
+	//	Whatever was delivered before the turn opened was not asked for
+	moveRequested = false;
+	pendingMove.store(NoMove, memory_order_relaxed);
+}
+
+void RemoteTurnController::TurnUpdateOperations()
+{
+	/*
+	 * Ask for the move on the first update of the turn, rather
+	 * than when it opens: when starting over, the first turn
+	 * opens before the field is reset, and the player must be
+	 * told about the board the move is for.
+	 */
+	if(!moveRequested)
+	{
+		link.RequestMove(gameField.GetBoard().GetLastMove());
+		moveRequested = true;
+	}
+
+	//	Check a move was delivered since the last update
+	const int cell = pendingMove.exchange(NoMove, memory_order_acquire);
+	if(cell == NoMove)
+		return;
+
+	//	Check it's an empty cell of the board
+	const Board & board = gameField.GetBoard();
+	if(
+		cell < 0 || cell >= board.GetCellsCount() ||
+		board.Get(cell) != FG_None
+	)
+	{
+		link.RejectMove(cell);
+		return;
+	}
+
+	//	Perform move
+	gameField.MakeMove(cell, GetFactionGlyph());
+
+	//	Conclude turn
+	Conclude();
+}
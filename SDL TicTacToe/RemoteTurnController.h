@@ -0,0 +1,55 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <atomic>
+#include <climits>
+#pragma endregion
+
+#pragma region Game Includes
+#include "ATurnController.h"
+#include "IRemoteLink.h"
+#include "Field.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Controller for a player taking part to the game from
+ * somewhere else, through a link. It implements ATurnController,
+ * which in turn implements ITurnsReceiver, so its lifecycle is
+ * entirely scheduled by the TurnsScheduler.
+ * On the first update of its turn it asks the player for a move
+ * through the link, then it waits for the move to be delivered,
+ * checking on each update: a move that can't be made is sent
+ * back, the player is expected to try again.
+ * Moves can be delivered from any thread (e.g. the one reading
+ * from the network), while the turn is only ever updated by the
+ * thread running the game. A move delivered before the turn
+ * opens is dropped, it can't be meant for this turn.
+ */
+class RemoteTurnController : public ATurnController
+{
+	// Fields
+public:
+	static const int NoMove = INT_MIN;	//	No cell at all, not even one out of the board, so every cell delivered gets an answer
+protected:
+private:
+	Field & gameField;
+	IRemoteLink & link;
+	atomic<int> pendingMove{NoMove};
+	bool moveRequested = false;
+	// Constructors
+public:
+	RemoteTurnController(Field & gameField, IRemoteLink & link, FactionGlyph factionGlyph);
+protected:
+private:
+	// Methods
+public:
+	__inline void DeliverMove(int cell) { pendingMove.store(cell, memory_order_release); }
+protected:
+private:
+	//	ATurnController implementation
+	void TurnOpeningOperations();
+	void TurnUpdateOperations();
+	void TurnClosingOperations() { }
+};
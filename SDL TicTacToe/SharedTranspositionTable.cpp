@@ -0,0 +1,128 @@
+#include "SharedTranspositionTable.h"
+
+#pragma region C++ Includes
+#include <algorithm>
+#include <cassert>
+#include <new>
+#pragma endregion
+
+#pragma region Constant Parameters
+//	Layout of an entry in its 64-bit word, from the lowest bit
+#define SCORE_BITS 32
+#define MOVE_BITS 16
+#define DEPTH_BITS 8	//	Deeper searches are stored as this deep, far beyond what time allows anyway
+#define BOUND_BITS 2
+#define GENERATION_BITS 6
+#define MOVE_SHIFT SCORE_BITS
+#define DEPTH_SHIFT (MOVE_SHIFT + MOVE_BITS)
+#define BOUND_SHIFT (DEPTH_SHIFT + DEPTH_BITS)
+#define GENERATION_SHIFT (BOUND_SHIFT + BOUND_BITS)
+#pragma endregion
+
+using namespace std;
+
+namespace
+{
+	__inline uint64_t GetField(uint64_t data, int shift, int bits)
+	{
+		return (data >> shift) & ((1ull << bits) - 1);
+	}
+}
+
+SharedTranspositionTable::SharedTranspositionTable(size_t megabytes)
+{
+	static_assert(sizeof(Bucket) == CacheLineSize, "A bucket must fill a cache line exactly");
+	static_assert(GENERATION_SHIFT + GENERATION_BITS == 64, "An entry must fill a word exactly");
+
+	size_t bucketsCount = 1;
+	while(bucketsCount * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024)
+		bucketsCount *= 2;
+	bucketsMask = bucketsCount - 1;
+
+	//	Aligned by hand, plain new only aligns to the fundamental alignment
+	storage.reset(new uint8_t[bucketsCount * sizeof(Bucket) + CacheLineSize]);
+	const uintptr_t address = ((uintptr_t)storage.get() + CacheLineSize - 1) & ~(uintptr_t)(CacheLineSize - 1);
+	buckets = (Bucket *)address;
+	for(size_t b = 0; b < bucketsCount; b++)
+		new(&buckets[b]) Bucket();
+
+	Clear();
+}
+
+bool SharedTranspositionTable::Probe(uint64_t hash, SharedTranspositionEntry & entry) const
+{
+	const Bucket & bucket = GetBucket(hash);
+	for(const Slot & slot : bucket.slots)
+	{
+		const uint64_t data = slot.data.load(memory_order_relaxed);
+		if((slot.check.load(memory_order_relaxed) ^ data) != hash)
+			continue;
+
+		//	An empty slot matches a hash of zero, it has no bound
+		const BoundType bound = (BoundType)GetField(data, BOUND_SHIFT, BOUND_BITS);
+		if(bound == BoundType::None)
+			return false;
+
+		entry.score = (int32_t)(uint32_t)GetField(data, 0, SCORE_BITS);
+		entry.bestMove = (int16_t)(uint16_t)GetField(data, MOVE_SHIFT, MOVE_BITS);
+		entry.depth = (int)GetField(data, DEPTH_SHIFT, DEPTH_BITS);
+		entry.bound = bound;
+		return true;
+	}
+
+	return false;
+}
+
+void SharedTranspositionTable::Store(uint64_t hash, int score, int bestMove, int depth, BoundType bound)
+{
+	assert(bound != BoundType::None);
+	assert(bestMove >= -1 && bestMove < (1 << (MOVE_BITS - 1)));
+
+	const uint64_t data =
+		(uint64_t)(uint32_t)score |
+		(uint64_t)(uint16_t)(int16_t)bestMove << MOVE_SHIFT |
+		(uint64_t)min(max(depth, 0), (1 << DEPTH_BITS) - 1) << DEPTH_SHIFT |
+		(uint64_t)bound << BOUND_SHIFT |
+		(uint64_t)generation << GENERATION_SHIFT;
+
+	//	The same position first, then the least worth keeping: older searches before shallower ones
+	Bucket & bucket = GetBucket(hash);
+	Slot * replaced = &bucket.slots[0];
+	int replacedWorth = INT32_MAX;
+	for(Slot & slot : bucket.slots)
+	{
+		const uint64_t slotData = slot.data.load(memory_order_relaxed);
+		if((slot.check.load(memory_order_relaxed) ^ slotData) == hash)
+		{
+			replaced = &slot;
+			break;
+		}
+
+		const bool current = GetField(slotData, GENERATION_SHIFT, GENERATION_BITS) == generation;
+		const int worth = (int)GetField(slotData, DEPTH_SHIFT, DEPTH_BITS) + (current ? 1 << DEPTH_BITS : 0);
+		if(worth < replacedWorth)
+		{
+			replaced = &slot;
+			replacedWorth = worth;
+		}
+	}
+
+	replaced->check.store(hash ^ data, memory_order_relaxed);
+	replaced->data.store(data, memory_order_relaxed);
+}
+
+void SharedTranspositionTable::NewSearch()
+{
+	//	Not while searching, the generation is read by the searching threads with no synchronization
+	generation = (generation + 1) & ((1u << GENERATION_BITS) - 1);
+}
+
+void SharedTranspositionTable::Clear()
+{
+	for(uint64_t b = 0; b <= bucketsMask; b++)
+		for(Slot & slot : buckets[b].slots)
+		{
+			slot.check.store(0, memory_order_relaxed);
+			slot.data.store(0, memory_order_relaxed);
+		}
+}
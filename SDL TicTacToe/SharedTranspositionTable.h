@@ -0,0 +1,89 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#pragma endregion
+
+#pragma region Game Includes
+#include "TranspositionTable.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * What the shared table remembers about a position: its score,
+ * how deep it was searched and how much the score can be
+ * trusted, and the best move found, tried first next time.
+ */
+struct SharedTranspositionEntry
+{
+	int score = 0;
+	int bestMove = -1;
+	int depth = 0;
+	BoundType bound = BoundType::None;
+};
+
+/*
+ * Memory of the searches on boards of any size, shared by all
+ * the threads searching at the same time, with no locks.
+ *
+ * Positions are identified by a 64-bit hash, which picks a
+ * bucket of four slots, as big as a cache line and aligned to
+ * one, so a probe touches a single line. Each slot is two
+ * words: the entry packed in one, and the hash XORed with it in
+ * the other. Threads read and write the words with no ordering
+ * at all, so a slot may be read halfway through being written by
+ * another thread: then the two words don't match the hash
+ * anymore, and the slot is just missed. Two positions with the
+ * same bucket and the same hash would be mixed up, with 64 bits
+ * that's once in a few billion lookups.
+ *
+ * A new entry takes the slot of the same position, if it's
+ * there, otherwise the slot of an older search, otherwise the
+ * one searched the least deep. Searches are told apart by a
+ * generation, bumped at the start of each, so the table doesn't
+ * need clearing between moves, and what's still good is reused.
+ */
+class SharedTranspositionTable
+{
+	// Fields
+public:
+	static const int CacheLineSize = 64;
+	static const int SlotsCount = 4;	//	Per bucket
+protected:
+private:
+	struct Slot
+	{
+		atomic<uint64_t> check;	//	Hash XOR data
+		atomic<uint64_t> data;
+	};
+	struct Bucket
+	{
+		Slot slots[SlotsCount];
+	};
+	unique_ptr<uint8_t[]> storage;
+	Bucket * buckets = nullptr;
+	uint64_t bucketsMask = 0;
+	unsigned int generation = 0;
+	// Constructors
+public:
+	//	Rounded down to a power of two buckets, at least one
+	SharedTranspositionTable(size_t megabytes);
+	//	Buckets are owned, no copies
+	SharedTranspositionTable(const SharedTranspositionTable &) = delete;
+	SharedTranspositionTable & operator=(const SharedTranspositionTable &) = delete;
+protected:
+private:
+	// Methods
+public:
+	bool Probe(uint64_t hash, SharedTranspositionEntry & entry) const;
+	void Store(uint64_t hash, int score, int bestMove, int depth, BoundType bound);
+	void NewSearch();
+	void Clear();
+	__inline size_t GetSize() const { return (size_t)(bucketsMask + 1) * sizeof(Bucket); }
+protected:
+private:
+	__inline Bucket & GetBucket(uint64_t hash) const { return buckets[hash & bucketsMask]; }
+};
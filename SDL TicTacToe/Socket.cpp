@@ -0,0 +1,188 @@
+#include "Socket.h"
+
+#pragma region Platform Includes
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+#pragma endregion
+
+#pragma region Platform Definitions
+#ifdef _WIN32
+typedef SOCKET NativeSocket;
+#define INVALID_HANDLE ((intptr_t)INVALID_SOCKET)
+#define CloseNativeSocket closesocket
+#define SHUTDOWN_BOTH SD_BOTH
+typedef int SocketLength;
+#else
+typedef int NativeSocket;
+#define INVALID_HANDLE ((intptr_t)-1)
+#define CloseNativeSocket close
+#define SHUTDOWN_BOTH SHUT_RDWR
+typedef socklen_t SocketLength;
+#endif
+
+//	Writing to a connection closed by the peer must fail, not kill the process
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+#pragma endregion
+
+Socket::Socket() :
+	handle(INVALID_HANDLE)
+{
+}
+
+Socket::~Socket()
+{
+	Close();
+}
+
+Socket::Socket(Socket && other) :
+	handle(other.handle)
+{
+	other.handle = INVALID_HANDLE;
+}
+
+Socket & Socket::operator=(Socket && other)
+{
+	if(this != &other)
+	{
+		Close();
+		handle = other.handle;
+		other.handle = INVALID_HANDLE;
+	}
+
+	return *this;
+}
+
+bool Socket::Startup()
+{
+#ifdef _WIN32
+	WSADATA data;
+	return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+	return true;
+#endif
+}
+
+bool Socket::Listen(uint16_t port, int backlog)
+{
+	Close();
+	handle = (intptr_t)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if(handle == INVALID_HANDLE)
+		return false;
+
+	//	A server started again right away can take its port back
+	const int reuse = 1;
+	setsockopt((NativeSocket)handle, SOL_SOCKET, SO_REUSEADDR, (const char *)&reuse, sizeof(reuse));
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(port);
+	if(
+		bind((NativeSocket)handle, (const sockaddr *)&address, sizeof(address)) != 0 ||
+		listen((NativeSocket)handle, backlog) != 0
+		)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+Socket Socket::Accept() const
+{
+	const NativeSocket accepted = accept((NativeSocket)handle, nullptr, nullptr);
+	return Socket((intptr_t)accepted);
+}
+
+bool Socket::Connect(uint16_t port)
+{
+	Close();
+	handle = (intptr_t)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if(handle == INVALID_HANDLE)
+		return false;
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(port);
+	if(connect((NativeSocket)handle, (const sockaddr *)&address, sizeof(address)) != 0)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+bool Socket::SendAll(const void * data, size_t size) const
+{
+	const char * bytes = (const char *)data;
+	while(size > 0)
+	{
+		const int sent = (int)send((NativeSocket)handle, bytes, (int)size, SEND_FLAGS);
+		if(sent <= 0)
+			return false;
+
+		bytes += sent;
+		size -= (size_t)sent;
+	}
+
+	return true;
+}
+
+int Socket::Receive(void * buffer, size_t size) const
+{
+	return (int)recv((NativeSocket)handle, (char *)buffer, (int)size, 0);
+}
+
+void Socket::SetNoDelay(bool noDelay) const
+{
+	const int value = noDelay ? 1 : 0;
+	setsockopt((NativeSocket)handle, IPPROTO_TCP, TCP_NODELAY, (const char *)&value, sizeof(value));
+}
+
+uint16_t Socket::GetLocalPort() const
+{
+	sockaddr_in address = {};
+	SocketLength length = sizeof(address);
+	if(getsockname((NativeSocket)handle, (sockaddr *)&address, &length) != 0)
+		return 0;
+
+	return ntohs(address.sin_port);
+}
+
+void Socket::Shutdown() const
+{
+	if(IsOpen())
+		shutdown((NativeSocket)handle, SHUTDOWN_BOTH);
+}
+
+void Socket::Close()
+{
+	if(!IsOpen())
+		return;
+
+	CloseNativeSocket((NativeSocket)handle);
+	handle = INVALID_HANDLE;
+}
+
+bool Socket::IsOpen() const
+{
+	return handle != INVALID_HANDLE;
+}
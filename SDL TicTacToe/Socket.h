@@ -0,0 +1,63 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <cstddef>
+#include <cstdint>
+#pragma endregion
+
+/*
+ * Minimal blocking TCP socket, on the loopback interface only:
+ * enough for processes on the same machine to talk to each other
+ * (e.g. remote players connecting to a local server), with no
+ * address resolution and nothing exposed to the network.
+ * Platform differences (Winsock on Windows, BSD sockets elsewhere)
+ * stay in the implementation.
+ *
+ * The socket is closed when the object goes away, and it can be
+ * moved but not copied, like any other owned handle.
+ * Reading and writing from two different threads is fine, while
+ * two threads writing at once must take turns.
+ */
+class Socket
+{
+	// Fields
+public:
+protected:
+private:
+	intptr_t handle;
+	// Constructors
+public:
+	Socket();
+	~Socket();
+	Socket(Socket && other);
+	Socket & operator=(Socket && other);
+	Socket(const Socket &) = delete;
+	Socket & operator=(const Socket &) = delete;
+protected:
+private:
+	explicit Socket(intptr_t handle) : handle(handle) { }
+	// Methods
+public:
+	//	Once per process, before any socket is used
+	static bool Startup();
+
+	//	Zero picks any free port, GetLocalPort tells which one
+	bool Listen(uint16_t port, int backlog = 64);
+	Socket Accept() const;
+	bool Connect(uint16_t port);
+
+	//	Blocks until everything is sent, fails if the connection is gone
+	bool SendAll(const void * data, size_t size) const;
+	//	Blocks until something arrives, returns the bytes received, zero when the connection is closed, less on errors
+	int Receive(void * buffer, size_t size) const;
+
+	//	Small messages leave right away instead of waiting to be grouped
+	void SetNoDelay(bool noDelay) const;
+	uint16_t GetLocalPort() const;
+	//	Unblocks whoever is waiting to receive, the socket stays open
+	void Shutdown() const;
+	void Close();
+	bool IsOpen() const;
+protected:
+private:
+};
@@ -1,14 +1,51 @@
 #include "SourceState.h"
 
-//	AxesState class
-SDL_Point AxesState::Delta(int id) const
+#include <climits>
+
+//	SparseSlots class
+const int SparseSlots::EmptyKey = INT_MIN;
+
+SparseSlots::SparseSlots(int capacity) :
+	capacity(capacity)
+{
+	//	Smallest power of two that keeps the table at most half full, so probe sequences stay short
+	int bucketsCount = 2;
+	int bucketsBits = 1;
+	while(bucketsCount < capacity * 2)
+	{
+		bucketsCount <<= 1;
+		bucketsBits++;
+	}
+	hashShift = 32 - bucketsBits;
+
+	keys.assign(bucketsCount, EmptyKey);
+	keySlots.assign(bucketsCount, -1);
+}
+
+int SparseSlots::Find(int id) const
 {
-	const SDL_Point previousPoint = GetPrevious(id);
-	const SDL_Point currentPoint = Get(id);
-	return {currentPoint.x - previousPoint.x, currentPoint.y - previousPoint.y};
+	//	Linear probing: walk from the id's bucket until the id or an empty bucket is found
+	const int mask = (int)keys.size() - 1;
+	for(int bucket = GetBucket(id); keys[bucket] != EmptyKey; bucket = (bucket + 1) & mask)
+		if(keys[bucket] == id)
+			return keySlots[bucket];
+
+	return -1;
 }
 
-//	ButtonsState class
-bool ButtonsState::GetPressed(int id) const { return !GetPrevious(id) && Get(id); }
+int SparseSlots::FindOrAdd(int id)
+{
+	const int mask = (int)keys.size() - 1;
+	int bucket = GetBucket(id);
+	for(; keys[bucket] != EmptyKey; bucket = (bucket + 1) & mask)
+		if(keys[bucket] == id)
+			return keySlots[bucket];
 
-bool ButtonsState::GetReleased(int id) const { return GetPrevious(id) && !Get(id); }
+	//	New id, take the next slot if any is left
+	if(usedSlots >= capacity)
+		return -1;
+
+	keys[bucket] = id;
+	keySlots[bucket] = usedSlots;
+	return usedSlots++;
+}
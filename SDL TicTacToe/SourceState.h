@@ -1,6 +1,6 @@
 #pragma once
 
-#include <map>
+#include <vector>
 
 #include <SDL.h>
 
@@ -13,38 +13,119 @@ using namespace std;
  * =============================================================
  */
 
+/*
+ * Sources are identified by an id (a mouse button, a key...)
+ * but states are stored in flat arrays, one slot per source:
+ * these classes tell which slot belongs to which id.
+ * Both allocate all the memory they'll ever need up front, so
+ * input handling never allocates after startup.
+ */
+
+/*
+ * For ids packed in a small range starting at zero (e.g. mouse
+ * buttons or scancodes): the id is the slot, no lookup at all.
+ * Ids out of range have no slot.
+ */
+class DenseSlots
+{
+private:
+	int capacity;
+public:
+	DenseSlots(int capacity) : capacity(capacity) { }
+	__inline int GetCapacity() const { return capacity; }
+	__inline int Find(int id) const { return id >= 0 && id < capacity ? id : -1; }
+	__inline int FindOrAdd(int id) { return Find(id); }
+};
+
+/*
+ * For ids scattered over a huge range (e.g. keycodes, which are
+ * characters for printable keys and scancodes with a high bit
+ * set for the others): slots are handed out in order of first
+ * use, and found through an open addressing hash table sized
+ * to stay at most half full.
+ * Once all slots are handed out, new ids have no slot.
+ */
+class SparseSlots
+{
+private:
+	static const int EmptyKey;
+	vector<int> keys;
+	vector<int> keySlots;
+	int capacity;
+	int usedSlots = 0;
+	int hashShift;
+public:
+	SparseSlots(int capacity);
+	__inline int GetCapacity() const { return capacity; }
+	int Find(int id) const;
+	int FindOrAdd(int id);
+private:
+	__inline int GetBucket(int id) const { return (int)(((unsigned int)id * 0x9E3779B1u) >> hashShift); }
+};
+
 /*
  * Template class for hardware states, implements a double buffer
- * based on maps where the key identifies the specific source and
- * the value identifies the state of that specific source.
+ * based on flat arrays where each source has a slot holding its
+ * state, and the slots of the sources are given by SlotsType.
  * Set operations are made on the curretn buffer, read operations
  * take into account either buffers and the buffers transition is
  * triggered by the State::Step funciton, to be called at the
  * beginning of each iteration.
+ * Sources set since the last step are kept in a dirty list, so
+ * stepping only copies what changed (sources that didn't change
+ * already hold the same value in both buffers) and costs nothing
+ * on frames without input, however many sources have been seen.
  */
-template<typename ValueType>
+template<typename ValueType, typename SlotsType>
 class State
 {
 private:
-	map<int, ValueType> previous;
-	map<int, ValueType> current;
+	SlotsType slots;
+	vector<ValueType> previous;
+	vector<ValueType> current;
+	vector<bool> dirty;
+	vector<int> dirtySlots;
 public:
-	void Set(int id, ValueType newValue) { current[id] = newValue; }
+	State(int capacity) :
+		slots(capacity),
+		previous(capacity, ValueType()),
+		current(capacity, ValueType()),
+		dirty(capacity, false)
+	{
+		dirtySlots.reserve(capacity);
+	}
+	void Set(int id, ValueType newValue)
+	{
+		const int slot = slots.FindOrAdd(id);
+		if(slot < 0)
+			return;
+
+		current[slot] = newValue;
+		if(!dirty[slot])
+		{
+			dirty[slot] = true;
+			dirtySlots.push_back(slot);
+		}
+	}
 	void Step()
 	{
-		for(const auto & row : current)
-			previous[row.first] = row.second;
+		for(const int slot : dirtySlots)
+		{
+			previous[slot] = current[slot];
+			dirty[slot] = false;
+		}
+		dirtySlots.clear();
 	}
 	ValueType Get(int id) const { return GetValue(id, current); }
 protected:
 	ValueType GetPrevious(int id) const { return GetValue(id, previous); }
 private:
-	ValueType GetValue(int id, const std::map<int, ValueType> & pool) const
+	ValueType GetValue(int id, const vector<ValueType> & pool) const
 	{
-		auto it = pool.find(id);
-		if(it == pool.end())
+		const int slot = slots.Find(id);
+		if(slot < 0)
 			return ValueType();
-		return it->second;
+		return pool[slot];
 	}
 };
 
@@ -54,10 +135,17 @@ private:
  * 1D axes must be mapped to SDL_Points so just one component,
  * typically the X component, will be used.
  */
-class AxesState : public State<SDL_Point>
+template<typename SlotsType>
+class AxesState : public State<SDL_Point, SlotsType>
 {
 public:
-	SDL_Point Delta(int id) const;
+	AxesState(int capacity) : State<SDL_Point, SlotsType>(capacity) { }
+	SDL_Point Delta(int id) const
+	{
+		const SDL_Point previousPoint = this->GetPrevious(id);
+		const SDL_Point currentPoint = this->Get(id);
+		return {currentPoint.x - previousPoint.x, currentPoint.y - previousPoint.y};
+	}
 	/*
 	 * Performance can be optimized by caching the delta
 	 * value each time Set is called, and then just returning
@@ -69,7 +157,7 @@ public:
 	 * creation of a struct) and would require a tiny refactoring
 	 * of the template class to allow post-set operations.
 	 * This project doesn't need that level of optimization.
-	 * 
+	 *
 	 * Also, such an optimization should be profiled since the
 	 * time spent making two subtractions and an allocation on
 	 * the stack, with subsequent copy, may not be more efficient
@@ -82,9 +170,11 @@ public:
  * Specialized state class for buttons where the value type is set to
  * bool. Useful for mouse, keyboard or gamepad buttons.
  */
-class ButtonsState : public State<bool>
+template<typename SlotsType>
+class ButtonsState : public State<bool, SlotsType>
 {
 public:
-	bool GetPressed(int id) const;
-	bool GetReleased(int id) const;
+	ButtonsState(int capacity) : State<bool, SlotsType>(capacity) { }
+	bool GetPressed(int id) const { return !this->GetPrevious(id) && this->Get(id); }
+	bool GetReleased(int id) const { return this->GetPrevious(id) && !this->Get(id); }
 };
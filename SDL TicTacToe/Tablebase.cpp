@@ -0,0 +1,259 @@
+#include "Tablebase.h"
+
+#pragma region C++ Includes
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#pragma endregion
+
+#pragma region Constant Parameters
+#define TABLEBASE_MAGIC "TTTB"
+#pragma endregion
+
+namespace
+{
+	//	Pascal's triangle, as far as a mask goes
+	struct BinomialTable
+	{
+		uint64_t values[Tablebase::MaxCellsCount + 1][Tablebase::MaxCellsCount + 1];
+
+		constexpr BinomialTable() :
+			values()
+		{
+			for(int n = 0; n <= Tablebase::MaxCellsCount; n++)
+			{
+				values[n][0] = 1;
+				for(int k = 1; k <= n; k++)
+					values[n][k] = values[n - 1][k - 1] + (k < n ? values[n - 1][k] : 0);
+			}
+		}
+	};
+
+	constexpr BinomialTable Binomials;
+
+	__inline int CountBits(TablebaseMask mask)
+	{
+		int count = 0;
+		for(; mask; mask &= mask - 1)
+			count++;
+		return count;
+	}
+
+	__inline TablebaseMask GetFullMask(int cellsCount)
+	{
+		return cellsCount >= 32 ? ~(TablebaseMask)0 : ((TablebaseMask)1 << cellsCount) - 1;
+	}
+}
+
+bool Tablebase::Open(const string & path)
+{
+	Close();
+	if(!file.OpenRead(path))
+		return false;
+
+	TablebaseHeader header;
+	if(file.GetSize() < sizeof(header))
+	{
+		Close();
+		return false;
+	}
+	memcpy(&header, file.GetData(), sizeof(header));
+
+	BoardRules fileRules;
+	fileRules.columns = header.columns;
+	fileRules.rows = header.rows;
+	fileRules.runLength = header.runLength;
+	if(
+		memcmp(header.magic, TABLEBASE_MAGIC, sizeof(header.magic)) != 0 ||
+		header.version != Version ||
+		!IsSupported(fileRules)
+	)
+	{
+		Close();
+		return false;
+	}
+
+	//	A file cut short would be read past its end
+	vector<uint64_t> fileLayerOffsets = GetLayerOffsets(fileRules);
+	if(
+		header.positionsCount != fileLayerOffsets.back() ||
+		file.GetSize() < sizeof(header) + (header.positionsCount + 3) / 4
+	)
+	{
+		Close();
+		return false;
+	}
+
+	rules = fileRules;
+	layerOffsets = move(fileLayerOffsets);
+	values = file.GetData() + sizeof(header);
+	return true;
+}
+
+void Tablebase::Close()
+{
+	file.Close();
+	values = nullptr;
+	layerOffsets.clear();
+	rules = BoardRules();
+}
+
+bool Tablebase::Covers(const BoardRules & boardRules) const
+{
+	return
+		IsOpen() &&
+		rules.columns == boardRules.columns &&
+		rules.rows == boardRules.rows &&
+		rules.runLength == boardRules.runLength;
+}
+
+TablebaseValue Tablebase::Lookup(TablebaseMask crossMask, TablebaseMask circleMask) const
+{
+	assert(IsOpen());
+	assert((crossMask & circleMask) == 0);
+
+	const int glyphsCount = CountBits(crossMask | circleMask);
+	assert(CountBits(crossMask) == GetCrossesCount(glyphsCount));	//	Shouldn't ever happen in a game, the cross always opens
+
+	const int cellsCount = rules.columns * rules.rows;
+	return GetValue(values, layerOffsets[glyphsCount] + GetLayerIndex(cellsCount, crossMask, circleMask));
+}
+
+TablebaseValue Tablebase::Lookup(const Board & board) const
+{
+	TablebaseMask crossMask;
+	TablebaseMask circleMask;
+	GetMasks(board, crossMask, circleMask);
+	return Lookup(crossMask, circleMask);
+}
+
+void Tablebase::GetMasks(const Board & board, TablebaseMask & crossMask, TablebaseMask & circleMask)
+{
+	assert(board.GetCellsCount() <= MaxCellsCount);
+
+	crossMask = 0;
+	circleMask = 0;
+	for(int cell = 0; cell < board.GetCellsCount(); cell++)
+		if(board.Get(cell) == FG_Cross)
+			crossMask |= (TablebaseMask)1 << cell;
+		else if(board.Get(cell) == FG_Circle)
+			circleMask |= (TablebaseMask)1 << cell;
+}
+
+bool Tablebase::IsSupported(const BoardRules & boardRules)
+{
+	return
+		boardRules.columns > 0 && boardRules.rows > 0 &&
+		boardRules.columns * boardRules.rows <= MaxCellsCount &&
+		boardRules.runLength > 0 && boardRules.runLength <= max(boardRules.columns, boardRules.rows);
+}
+
+vector<uint64_t> Tablebase::GetLayerOffsets(const BoardRules & boardRules)
+{
+	//	Each layer starts on a byte of its own, so layers can be written at the same time
+	const int cellsCount = boardRules.columns * boardRules.rows;
+	vector<uint64_t> offsets(cellsCount + 2, 0);
+	for(int glyphsCount = 0; glyphsCount <= cellsCount; glyphsCount++)
+		offsets[glyphsCount + 1] = offsets[glyphsCount] + (GetLayerSize(cellsCount, glyphsCount) + 3) / 4 * 4;
+
+	return offsets;
+}
+
+uint64_t Tablebase::GetLayerSize(int cellsCount, int glyphsCount)
+{
+	const int crossesCount = GetCrossesCount(glyphsCount);
+	return GetBinomial(cellsCount, crossesCount) * GetBinomial(cellsCount - crossesCount, GetCirclesCount(glyphsCount));
+}
+
+uint64_t Tablebase::GetLayerIndex(int cellsCount, TablebaseMask crossMask, TablebaseMask circleMask)
+{
+	const int crossesCount = CountBits(crossMask);
+	const TablebaseMask freeCells = GetFullMask(cellsCount) & ~crossMask;
+	return
+		RankCombination(crossMask) * GetBinomial(cellsCount - crossesCount, CountBits(circleMask)) +
+		RankCombination(Compress(circleMask, freeCells));
+}
+
+void Tablebase::GetLayerMasks(int cellsCount, int glyphsCount, uint64_t layerIndex, TablebaseMask & crossMask, TablebaseMask & circleMask)
+{
+	const int crossesCount = GetCrossesCount(glyphsCount);
+	const int circlesCount = GetCirclesCount(glyphsCount);
+	const uint64_t circleCombinations = GetBinomial(cellsCount - crossesCount, circlesCount);
+
+	crossMask = UnrankCombination(layerIndex / circleCombinations, crossesCount);
+	circleMask = Expand(UnrankCombination(layerIndex % circleCombinations, circlesCount), GetFullMask(cellsCount) & ~crossMask);
+}
+
+TablebaseHeader Tablebase::MakeHeader(const BoardRules & boardRules)
+{
+	TablebaseHeader header;
+	memcpy(header.magic, TABLEBASE_MAGIC, sizeof(header.magic));
+	header.version = Version;
+	header.columns = boardRules.columns;
+	header.rows = boardRules.rows;
+	header.runLength = boardRules.runLength;
+	header.reserved = 0;
+	header.positionsCount = GetLayerOffsets(boardRules).back();
+	return header;
+}
+
+uint64_t Tablebase::GetBinomial(int n, int k)
+{
+	if(k < 0 || k > n)
+		return 0;
+
+	return Binomials.values[n][k];
+}
+
+uint64_t Tablebase::RankCombination(TablebaseMask mask)
+{
+	//	Combinations with the same highest cell come after all those with lower ones: C(cell, j) of them for the j-th cell
+	uint64_t rank = 0;
+	for(int j = 1; mask; mask &= mask - 1, j++)
+	{
+		int cell = 0;
+		while(!(mask & ((TablebaseMask)1 << cell)))
+			cell++;
+		rank += GetBinomial(cell, j);
+	}
+
+	return rank;
+}
+
+TablebaseMask Tablebase::UnrankCombination(uint64_t rank, int bitsCount)
+{
+	//	From the highest cell down, the highest one whose combinations before it are not more than the rank
+	TablebaseMask mask = 0;
+	for(int j = bitsCount; j > 0; j--)
+	{
+		int cell = j - 1;
+		while(cell < MaxCellsCount && GetBinomial(cell + 1, j) <= rank)
+			cell++;
+		rank -= GetBinomial(cell, j);
+		mask |= (TablebaseMask)1 << cell;
+	}
+
+	return mask;
+}
+
+TablebaseMask Tablebase::Compress(TablebaseMask mask, TablebaseMask within)
+{
+	//	Bits of the mask at the cells of within, packed together from the lowest
+	TablebaseMask compressed = 0;
+	for(TablebaseMask bit = 1; within; within &= within - 1, bit <<= 1)
+		if(mask & within & (~within + 1))
+			compressed |= bit;
+
+	return compressed;
+}
+
+TablebaseMask Tablebase::Expand(TablebaseMask mask, TablebaseMask within)
+{
+	//	The other way around, packed bits spread back to the cells of within
+	TablebaseMask expanded = 0;
+	for(TablebaseMask bit = 1; within; within &= within - 1, bit <<= 1)
+		if(mask & bit)
+			expanded |= within & (~within + 1);
+
+	return expanded;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <cstdint>
+#include <string>
+#include <vector>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "MappedFile.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "Board.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Game-theoretic value of a position, seen from the faction to
+ * move, when both factions play perfectly from there on.
+ */
+enum TablebaseValue : uint8_t
+{
+	TV_Loss,
+	TV_Draw,
+	TV_Win
+};
+
+//	One bit per cell, the lowest for cell 0
+typedef uint32_t TablebaseMask;
+
+/*
+ * Start of a tablebase file, followed by two bits per position,
+ * four positions per byte starting from the lowest bits.
+ */
+struct TablebaseHeader
+{
+	char magic[4];
+	uint32_t version;
+	int32_t columns;
+	int32_t rows;
+	int32_t runLength;
+	uint32_t reserved;
+	uint64_t positionsCount;
+};
+
+/*
+ * Value of every position of a board bigger than the classic
+ * one, solved once and for all by the tablebase tool and saved
+ * to a file, mapped in memory when opened: processes opening
+ * the same file share its pages, and any position is a lookup
+ * away from the moment the file is open, with no loading.
+ *
+ * Only positions the game can reach by the glyph counts are
+ * stored (the cross opens, so it has as many glyphs as the
+ * circle or one more), and each one has its own slot, given
+ * by a perfect index, with nothing wasted in between:
+ * - positions are grouped by the number of glyphs on the board,
+ *		each group starting on a byte of its own
+ * - within a group, positions are numbered by the cells of the
+ *		crosses among all the cells, then by the cells of the
+ *		circles among the cells left empty by the crosses, both
+ *		ranked among the combinations of as many cells
+ * The indexing is public, the tool solving the tables walks
+ * positions the same way.
+ */
+class Tablebase
+{
+	// Fields
+public:
+	static const int MaxCellsCount = 32;
+	static const uint32_t Version = 1;
+protected:
+private:
+	BoardRules rules;
+	vector<uint64_t> layerOffsets;
+	MappedFile file;
+	const uint8_t * values = nullptr;
+	// Constructors
+public:
+	Tablebase() { }
+protected:
+private:
+	// Methods
+public:
+	//	Fails if the file is missing or is not a tablebase
+	bool Open(const string & path);
+	void Close();
+	__inline bool IsOpen() const { return values != nullptr; }
+	__inline const BoardRules & GetRules() const { return rules; }
+	bool Covers(const BoardRules & boardRules) const;
+
+	//	Positions with a glyph count the game can't reach can't be looked up
+	TablebaseValue Lookup(TablebaseMask crossMask, TablebaseMask circleMask) const;
+	TablebaseValue Lookup(const Board & board) const;
+	static void GetMasks(const Board & board, TablebaseMask & crossMask, TablebaseMask & circleMask);
+
+	//	Indexing
+	static bool IsSupported(const BoardRules & boardRules);
+	static vector<uint64_t> GetLayerOffsets(const BoardRules & boardRules);	//	By glyphs count, one more for the positions count
+	static uint64_t GetLayerSize(int cellsCount, int glyphsCount);
+	static uint64_t GetLayerIndex(int cellsCount, TablebaseMask crossMask, TablebaseMask circleMask);
+	static void GetLayerMasks(int cellsCount, int glyphsCount, uint64_t layerIndex, TablebaseMask & crossMask, TablebaseMask & circleMask);
+	static TablebaseHeader MakeHeader(const BoardRules & boardRules);
+
+	//	Combinations of cells, in colexicographic order (the order of the masks as numbers)
+	static uint64_t GetBinomial(int n, int k);
+	static uint64_t RankCombination(TablebaseMask mask);
+	static TablebaseMask UnrankCombination(uint64_t rank, int bitsCount);
+	static TablebaseMask Compress(TablebaseMask mask, TablebaseMask within);
+	static TablebaseMask Expand(TablebaseMask mask, TablebaseMask within);
+
+	__inline static int GetCrossesCount(int glyphsCount) { return (glyphsCount + 1) / 2; }
+	__inline static int GetCirclesCount(int glyphsCount) { return glyphsCount / 2; }
+	__inline static TablebaseValue GetValue(const uint8_t * values, uint64_t index) { return (TablebaseValue)((values[index >> 2] >> ((index & 3) * 2)) & 3); }
+protected:
+private:
+};
@@ -0,0 +1,90 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int workersCount) :
+	workersCount(workersCount > 0 ? workersCount : GetHardwareThreadsCount())
+{
+#ifdef __EMSCRIPTEN__
+	this->workersCount = 1;
+#else
+	//	Worker 0 is whoever calls Run
+	for(int worker = 1; worker < this->workersCount; worker++)
+		threads.emplace_back(&ThreadPool::WorkerLoop, this, worker);
+#endif
+}
+
+ThreadPool::~ThreadPool()
+{
+#ifndef __EMSCRIPTEN__
+	{
+		lock_guard<mutex> lock(stateMutex);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+	for(thread & workerThread : threads)
+		workerThread.join();
+#endif
+}
+
+void ThreadPool::Run(const function<void(int)> & task)
+{
+#ifdef __EMSCRIPTEN__
+	task(0);
+#else
+	lock_guard<mutex> runLock(runMutex);
+
+	//	Wake up the workers, each one knows there's work by the generation changing
+	{
+		lock_guard<mutex> lock(stateMutex);
+		currentTask = &task;
+		pendingWorkers = (int)threads.size();
+		generation++;
+	}
+	workAvailable.notify_all();
+
+	//	Do this thread's share, then wait for the others
+	task(0);
+
+	unique_lock<mutex> lock(stateMutex);
+	workDone.wait(lock, [this] { return pendingWorkers == 0; });
+	currentTask = nullptr;
+#endif
+}
+
+int ThreadPool::GetHardwareThreadsCount()
+{
+#ifdef __EMSCRIPTEN__
+	return 1;
+#else
+	//	Zero when unknown
+	const unsigned int hardwareThreads = thread::hardware_concurrency();
+	return hardwareThreads > 0 ? (int)hardwareThreads : 1;
+#endif
+}
+
+#ifndef __EMSCRIPTEN__
+void ThreadPool::WorkerLoop(int worker)
+{
+	unsigned long long lastGeneration = 0;
+	while(true)
+	{
+		const function<void(int)> * task;
+		{
+			unique_lock<mutex> lock(stateMutex);
+			workAvailable.wait(lock, [this, lastGeneration] { return stopping || generation != lastGeneration; });
+			if(stopping)
+				return;
+
+			lastGeneration = generation;
+			task = currentTask;
+		}
+
+		(*task)(worker);
+
+		{
+			lock_guard<mutex> lock(stateMutex);
+			pendingWorkers--;
+		}
+		workDone.notify_one();
+	}
+}
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <functional>
+#ifndef __EMSCRIPTEN__
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Fork-join pool of worker threads, for work that can be split
+ * among threads which all do the same thing (e.g. running
+ * playouts for the same search).
+ * Run hands the same task to every worker, each one receiving
+ * its own index, and returns when all of them are done: the
+ * calling thread is worker 0 and does its share of the work
+ * instead of just waiting, so a pool of N workers only keeps
+ * N - 1 threads of its own, asleep while there's no work.
+ *
+ * Only one Run at a time: callers from different threads wait
+ * for their turn.
+ *
+ * Web builds have no threads, there the pool has a single
+ * worker, the calling thread, and Run just calls the task.
+ */
+class ThreadPool
+{
+	// Fields
+public:
+protected:
+private:
+	int workersCount;
+#ifndef __EMSCRIPTEN__
+	vector<thread> threads;
+	mutex runMutex;
+	mutex stateMutex;
+	condition_variable workAvailable;
+	condition_variable workDone;
+	const function<void(int)> * currentTask = nullptr;
+	unsigned long long generation = 0;
+	int pendingWorkers = 0;
+	bool stopping = false;
+#endif
+	// Constructors
+public:
+	//	Zero or less for one worker per hardware thread
+	ThreadPool(int workersCount = 0);
+	~ThreadPool();
+	//	Threads are owned, no copies
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool & operator=(const ThreadPool &) = delete;
+protected:
+private:
+	// Methods
+public:
+	__inline int GetWorkersCount() const { return workersCount; }
+	void Run(const function<void(int)> & task);
+
+	static int GetHardwareThreadsCount();
+protected:
+private:
+#ifndef __EMSCRIPTEN__
+	void WorkerLoop(int worker);
+#endif
+};
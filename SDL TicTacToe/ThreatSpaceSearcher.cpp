@@ -0,0 +1,374 @@
+#include "ThreatSpaceSearcher.h"
+
+#pragma region C++ Includes
+#include <algorithm>
+#include <cassert>
+#include <random>
+#pragma endregion
+
+#pragma region Constant Parameters
+#define DEADLINE_CHECK_NODES 256	//	Power of two, nodes searched between two looks at the clock
+#define MIN_THREES_RUN_LENGTH 4	//	On shorter runs nearly every move is a three, they'd be no threat at all
+#define ZOBRIST_SEED 0x7472656174ull	//	Keys of its own, so the game's random numbers are left alone
+#pragma endregion
+
+using namespace std;
+
+ThreatSpaceSearcher::ThreatSpaceSearcher(const ThreatSettings & settings) :
+	settings(settings)
+{
+}
+
+ThreatResult ThreatSpaceSearcher::Search(const Board & searchedBoard, FactionGlyph attacker, const atomic<bool> * cancelled, bool virtualTime)
+{
+	assert(attacker != FG_None);
+
+	ThreatResult result;
+	if(searchedBoard.IsGameOver())
+		return result;
+
+	const steady_clock::time_point start = steady_clock::now();
+	deadline = start + milliseconds(settings.timeBudgetMillis);
+	nodesBudget = virtualTime ? max(1ull, (unsigned long long)settings.timeBudgetMillis * settings.virtualNodesPerMilli) : 0;
+	this->cancelled = cancelled;
+	nodesSearched = 0;
+	aborted = false;
+
+	PrepareBoard(searchedBoard);
+	for(unordered_map<uint64_t, Failure> & memo : failures)
+		memo.clear();
+
+	/*
+	 * Through fours first, exact and cheap even deep down, then
+	 * with threes, which branch far more, for as long as the time
+	 * budget allows. Each with the shortest win first, and no
+	 * deeper once no line of threats was cut short by the depth.
+	 */
+	const bool threes = settings.threes && runLength >= MIN_THREES_RUN_LENGTH;
+	for(int withThrees = 0; withThrees <= (threes ? 1 : 0) && !result.IsWin() && !aborted; withThrees++)
+		for(int depth = 1; depth <= settings.maxDepth; depth++)
+		{
+			depthCut = false;
+			proof.clear();
+
+			int winningMove = -1;
+			if(Attack(depth, 0, attacker, withThrees != 0, winningMove))
+			{
+				//	One more move to complete the run, unless it's there already
+				result.winningMove = winningMove;
+				result.winDepth = GetThreatCells(attacker, TK_Win).empty() ? depth + 1 : 1;
+				break;
+			}
+
+			if(aborted || !depthCut)
+				break;
+		}
+
+	result.nodesSearched = nodesSearched;
+	result.elapsedSeconds = duration<double>(steady_clock::now() - start).count();
+	return result;
+}
+
+bool ThreatSpaceSearcher::Attack(int depth, int ply, FactionGlyph attacker, bool withThrees, int & winningMove)
+{
+	/*
+	 * Depth counts the moves the attacker has left. The cells of
+	 * a win found are added to the proof on the way back, so a
+	 * three knows what the opponent could stand in the way of.
+	 */
+	if((++nodesSearched & (DEADLINE_CHECK_NODES - 1)) == 0 && IsTimeUp())
+		aborted = true;
+	if(aborted)
+		return false;
+
+	//	A run one glyph away from the end, it's over
+	const vector<int> & wins = GetThreatCells(attacker, TK_Win);
+	if(!wins.empty())
+	{
+		winningMove = wins[0];
+		proof.insert(proof.end(), wins.begin(), wins.end());
+		return true;
+	}
+
+	if(depth == 0)
+	{
+		depthCut = true;
+		return false;
+	}
+
+	/*
+	 * An opponent one glyph away from winning must be stopped,
+	 * it's the only move, and it goes on only if it's a threat
+	 * itself. Otherwise, every four and three is tried, the ones
+	 * making the most threats at once first.
+	 */
+	const FactionGlyph defender = GetOpponentGlyph(attacker);
+	const vector<int> & defenderWins = GetThreatCells(defender, TK_Win);
+	if(defenderWins.size() > 1)
+		return false;
+
+	//	Lost already, as deep or with nothing cut short by the depth
+	unordered_map<uint64_t, Failure> & memo = failures[withThrees ? 1 : 0];
+	const auto failure = memo.find(hash);
+	if(failure != memo.end() && (!failure->second.depthCut || failure->second.depth >= depth))
+	{
+		depthCut |= failure->second.depthCut;
+		return false;
+	}
+	const bool outerDepthCut = depthCut;
+	depthCut = false;
+
+	if(candidatesByPly.size() < (size_t)ply + 1)
+		candidatesByPly.resize(ply + 1);
+	vector<int> & candidates = candidatesByPly[ply];
+	candidates.clear();
+	if(!defenderWins.empty())
+		candidates.push_back(defenderWins[0]);
+	else
+	{
+		const vector<int> & fours = GetThreatCells(attacker, TK_Four);
+		candidates.assign(fours.begin(), fours.end());
+		if(withThrees)
+			for(const int cell : GetThreatCells(attacker, TK_Three))
+				if(GetThreatsCount(attacker, TK_Four, cell) == 0)
+					candidates.push_back(cell);
+
+		//	Ties broken by cell, so the same position is always searched the same way
+		sort(candidates.begin(), candidates.end(), [this, attacker](int a, int b)
+		{
+			const int aOrder = GetThreatsCount(attacker, TK_Four, a) * 16 + GetThreatsCount(attacker, TK_Three, a);
+			const int bOrder = GetThreatsCount(attacker, TK_Four, b) * 16 + GetThreatsCount(attacker, TK_Three, b);
+			return aOrder != bOrder ? aOrder > bOrder : a < b;
+		});
+	}
+
+	for(const int cell : candidates)
+	{
+		MakeMove(cell, attacker);
+
+		bool won = false;
+		const vector<int> & gaps = GetThreatCells(attacker, TK_Win);
+		if(gaps.size() > 1)
+		{
+			//	Two fours at once, only one can be stopped
+			proof.insert(proof.end(), gaps.begin(), gaps.end());
+			won = true;
+		}
+		else if(gaps.size() == 1)
+		{
+			//	A four, the opponent has a single answer
+			const int gap = gaps[0];
+			MakeMove(gap, defender);
+			int nextMove;
+			won = Attack(depth - 1, ply + 1, attacker, withThrees, nextMove);
+			UndoMove(gap);
+			if(won)
+				proof.push_back(gap);
+		}
+		else if(withThrees && GetThreatCells(defender, TK_Win).empty())
+			won = DefendThree(depth, ply, attacker);
+
+		UndoMove(cell);
+
+		if(won)
+		{
+			proof.push_back(cell);
+			winningMove = cell;
+			depthCut |= outerDepthCut;
+			return true;
+		}
+		if(aborted)
+			return false;
+	}
+
+	//	Only a search that went through to the end proves anything
+	memo[hash] = Failure{depth, depthCut};
+	depthCut |= outerDepthCut;
+	return false;
+}
+
+bool ThreatSpaceSearcher::DefendThree(int depth, int ply, FactionGlyph attacker)
+{
+	/*
+	 * A three is a threat only if, left alone, it leads to a win
+	 * through fours. If it does, the opponent must stand in the
+	 * way of that win, taking one of its cells, or make a four of
+	 * its own to take the lead: every such answer must still lose
+	 * for the three to win.
+	 */
+	const size_t proofStart = proof.size();
+	int nextMove;
+	if(!Attack(depth - 1, ply + 1, attacker, false, nextMove))
+		return false;
+
+	const FactionGlyph defender = GetOpponentGlyph(attacker);
+	vector<int> defenses(proof.begin() + proofStart, proof.end());
+	proof.resize(proofStart);
+	const vector<int> & counterFours = GetThreatCells(defender, TK_Four);
+	defenses.insert(defenses.end(), counterFours.begin(), counterFours.end());
+	sort(defenses.begin(), defenses.end());
+	defenses.erase(unique(defenses.begin(), defenses.end()), defenses.end());
+
+	for(const int defense : defenses)
+	{
+		MakeMove(defense, defender);
+		const bool won = Attack(depth - 1, ply + 1, attacker, true, nextMove);
+		UndoMove(defense);
+		proof.resize(proofStart);
+
+		if(!won)
+			return false;
+	}
+
+	return true;
+}
+
+void ThreatSpaceSearcher::MakeMove(int cell, FactionGlyph glyph)
+{
+	UpdateRuns(cell, glyph, 1);
+}
+
+void ThreatSpaceSearcher::UndoMove(int cell)
+{
+	UpdateRuns(cell, board.Get(cell), -1);
+}
+
+void ThreatSpaceSearcher::UpdateRuns(int cell, FactionGlyph glyph, int change)
+{
+	/*
+	 * Only the runs through the cell change: their threats are
+	 * taken away as they were, then counted again as they are.
+	 */
+	const int faction = GetFaction(glyph);
+	const int firstRun = cellRunsOffsets[cell];
+	const int lastRun = cellRunsOffsets[cell + 1];
+	for(int r = firstRun; r < lastRun; r++)
+		CountThreats(cellRuns[r], -1);
+
+	if(change > 0)
+		board.MakeMove(cell, glyph);
+	else
+		board.UndoMove(cell);
+	hash ^= zobristKeys[faction][cell];
+
+	for(int r = firstRun; r < lastRun; r++)
+	{
+		runGlyphs[faction][cellRuns[r]] += change;
+		CountThreats(cellRuns[r], 1);
+	}
+}
+
+void ThreatSpaceSearcher::CountThreats(int run, int change)
+{
+	//	A run with glyphs of both factions is no threat to anybody
+	for(int faction = 0; faction < 2; faction++)
+	{
+		if(runGlyphs[1 - faction][run] != 0)
+			continue;
+
+		const int missingGlyphs = runLength - runGlyphs[faction][run];
+		if(missingGlyphs < 1 || missingGlyphs > TK_Count)
+			continue;
+
+		const ThreatKind kind = (ThreatKind)(missingGlyphs - 1);
+		for(int c = 0, cell = runStarts[run]; c < runLength; c++, cell += runSteps[run])
+			if(board.Get(cell) == FG_None)
+				CountThreat(faction, kind, cell, change);
+	}
+}
+
+void ThreatSpaceSearcher::CountThreat(int faction, ThreatKind kind, int cell, int change)
+{
+	ThreatCells & threatCells = threats[faction][kind];
+	const int count = threatCells.counts[cell] += change;
+
+	//	The cell joins the list with its first threat of the kind, and leaves it with its last
+	if(count == 1 && change > 0)
+	{
+		threatCells.slots[cell] = (int)threatCells.cells.size();
+		threatCells.cells.push_back(cell);
+	}
+	else if(count == 0)
+	{
+		const int slot = threatCells.slots[cell];
+		const int lastCell = threatCells.cells.back();
+		threatCells.cells[slot] = lastCell;
+		threatCells.slots[lastCell] = slot;
+		threatCells.cells.pop_back();
+	}
+}
+
+void ThreatSpaceSearcher::PrepareBoard(const Board & searchedBoard)
+{
+	/*
+	 * Runs only depend on the rules, they're listed again only
+	 * when the rules change. The board is then rebuilt move by
+	 * move from an empty one, so threats are counted the same
+	 * way the search counts them.
+	 */
+	const BoardRules & rules = searchedBoard.GetRules();
+	const int cellsCount = searchedBoard.GetCellsCount();
+	if(
+		board.GetColumns() != rules.columns || board.GetRows() != rules.rows ||
+		runLength != rules.runLength || cellRunsOffsets.empty()
+	)
+	{
+		board = Board(rules);
+		runLength = rules.runLength;
+		runStarts.clear();
+		runSteps.clear();
+		for(int cell = 0; cell < cellsCount; cell++)
+			for(int direction = 0; direction < Board::DirectionsCount; direction++)
+			{
+				const int rowStep = Board::Directions[direction][0];
+				const int colStep = Board::Directions[direction][1];
+				if(!board.IsInside(board.GetRow(cell) + (runLength - 1) * rowStep, board.GetColumn(cell) + (runLength - 1) * colStep))
+					continue;
+
+				runStarts.push_back(cell);
+				runSteps.push_back(rowStep * rules.columns + colStep);
+			}
+		runsCount = (int)runStarts.size();
+
+		//	Runs through each cell, packed one cell after the other
+		cellRunsOffsets.assign(cellsCount + 1, 0);
+		for(int run = 0; run < runsCount; run++)
+			for(int c = 0; c < runLength; c++)
+				cellRunsOffsets[runStarts[run] + c * runSteps[run] + 1]++;
+		for(int cell = 0; cell < cellsCount; cell++)
+			cellRunsOffsets[cell + 1] += cellRunsOffsets[cell];
+		cellRuns.resize(cellRunsOffsets[cellsCount]);
+		vector<int> filled(cellRunsOffsets.begin(), cellRunsOffsets.end() - 1);
+		for(int run = 0; run < runsCount; run++)
+			for(int c = 0; c < runLength; c++)
+				cellRuns[filled[runStarts[run] + c * runSteps[run]]++] = run;
+
+		mt19937_64 keysEngine(ZOBRIST_SEED);
+		for(vector<uint64_t> & keys : zobristKeys)
+		{
+			keys.resize(cellsCount);
+			for(uint64_t & key : keys)
+				key = keysEngine();
+		}
+	}
+	else
+		board.Reset();
+
+	for(int faction = 0; faction < 2; faction++)
+	{
+		runGlyphs[faction].assign(runsCount, 0);
+		for(ThreatCells & threatCells : threats[faction])
+		{
+			threatCells.cells.clear();
+			threatCells.slots.assign(cellsCount, -1);
+			threatCells.counts.assign(cellsCount, 0);
+		}
+	}
+	for(int run = 0; run < runsCount; run++)
+		CountThreats(run, 1);
+	hash = 0;
+
+	for(int cell = 0; cell < cellsCount; cell++)
+		if(searchedBoard.Get(cell) != FG_None)
+			MakeMove(cell, searchedBoard.Get(cell));
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "Board.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * How long a threat-space search may take, and how far it goes.
+ */
+struct ThreatSettings
+{
+	int timeBudgetMillis = 50;	//	Hard deadline, a forced win not found by then is given up (in nodes on virtual time)
+	int maxDepth = 16;	//	Most moves of the attacker in a forced win
+	bool threes = true;	//	Threes as well as fours (only on boards with runs of four or more)
+	int virtualNodesPerMilli = 500;	//	Nodes worth a millisecond of the budget on virtual time, more than for the deepening search: only threat cells are tried and nothing is evaluated
+};
+
+/*
+ * Outcome of a threat-space search: the first move of a forced
+ * win (-1 when none was found), how many moves of the attacker
+ * it takes to win, and telemetry about the work it took.
+ */
+struct ThreatResult
+{
+	int winningMove = -1;
+	int winDepth = 0;
+	unsigned long long nodesSearched = 0;
+	double elapsedSeconds = 0.0;
+	__inline bool IsWin() const { return winningMove > -1; }
+};
+
+/*
+ * Search for forced wins on boards of any size, through threats
+ * only: moves the opponent must answer at once, so the tree
+ * stays narrow and goes deep, where a full search can't.
+ * - a four leaves a single cell to complete a run: the opponent
+ *		has a single answer, and two fours at once win
+ * - a three leaves two cells to complete a run: it threatens a
+ *		four, so it's only played when the four would go on to a
+ *		forced win, and the opponent's answers are the cells of
+ *		that win (what else would let it go through), and the
+ *		fours the opponent can make on its own
+ * Searching through fours only is exact (VCF, victory by
+ * continuous fours); threes make it a VCT, which may miss the odd
+ * defense far from the threats, like any threat-space search.
+ *
+ * Threats are counted on the board itself and kept up to date
+ * move by move: every run of cells long enough to win holds a
+ * count of glyphs for each faction, and every empty cell knows,
+ * for each faction, how many runs it would bring to a win, to a
+ * four and to a three. A move only changes the runs through its
+ * own cell, and the cells making each kind of threat are kept in
+ * lists, so threats are enumerated without scanning the board.
+ *
+ * Wins are searched with increasing depth, so the shortest one
+ * is found first. Positions found lost for the attacker are
+ * remembered by their hash for the rest of the search, the same
+ * threats played in another order reach them again and again.
+ * Like the other searchers, it works on its own copy of the
+ * board and can be called off through a flag, and on virtual
+ * time its budget is counted in nodes, so whether a win is
+ * found doesn't depend on the machine.
+ */
+class ThreatSpaceSearcher
+{
+	// Fields
+public:
+protected:
+private:
+	//	Kinds of threat a cell makes, by the glyphs its runs would hold
+	enum ThreatKind
+	{
+		TK_Win,
+		TK_Four,
+		TK_Three,
+		TK_Count
+	};
+
+	//	Cells with at least one threat of a kind, in a dense list paired with the slot of each cell
+	struct ThreatCells
+	{
+		vector<int> cells;
+		vector<int> slots;
+		vector<int> counts;
+	};
+
+	//	Deepest search a position had no win for, and whether a deeper one might
+	struct Failure
+	{
+		int depth;
+		bool depthCut;
+	};
+
+	ThreatSettings settings;
+	Board board;
+	int runLength = 0;
+	int runsCount = 0;
+	vector<int> runStarts;
+	vector<int> runSteps;
+	vector<int> cellRunsOffsets;	//	Runs through each cell, in cellRuns
+	vector<int> cellRuns;
+	vector<uint8_t> runGlyphs[2];	//	By faction, cross first
+	ThreatCells threats[2][TK_Count];
+	vector<uint64_t> zobristKeys[2];	//	By faction and cell
+	uint64_t hash = 0;
+	unordered_map<uint64_t, Failure> failures[2];	//	Through fours only, and with threes
+	vector<vector<int>> candidatesByPly;
+	vector<int> proof;	//	Cells of the last forced win found, both factions' moves
+	steady_clock::time_point deadline;
+	unsigned long long nodesBudget = 0;	//	On virtual time only, the deadline is left alone
+	const atomic<bool> * cancelled = nullptr;
+	unsigned long long nodesSearched = 0;
+	bool aborted = false;
+	bool depthCut = false;	//	Some line of threats went on past the depth searched
+	// Constructors
+public:
+	ThreatSpaceSearcher(const ThreatSettings & settings = ThreatSettings());
+protected:
+private:
+	// Methods
+public:
+	ThreatResult Search(const Board & board, FactionGlyph attacker, const atomic<bool> * cancelled = nullptr, bool virtualTime = false);
+	__inline const ThreatSettings & GetSettings() const { return settings; }
+protected:
+private:
+	bool Attack(int depth, int ply, FactionGlyph attacker, bool withThrees, int & winningMove);
+	bool DefendThree(int depth, int ply, FactionGlyph attacker);
+	void MakeMove(int cell, FactionGlyph glyph);
+	void UndoMove(int cell);
+	void UpdateRuns(int cell, FactionGlyph glyph, int change);
+	void CountThreats(int run, int change);
+	void CountThreat(int faction, ThreatKind kind, int cell, int change);
+	void PrepareBoard(const Board & searchedBoard);
+	__inline static int GetFaction(FactionGlyph glyph) { return glyph == FG_Cross ? 0 : 1; }
+	__inline const vector<int> & GetThreatCells(FactionGlyph glyph, ThreatKind kind) const { return threats[GetFaction(glyph)][kind].cells; }
+	__inline int GetThreatsCount(FactionGlyph glyph, ThreatKind kind, int cell) const { return threats[GetFaction(glyph)][kind].counts[cell]; }
+	__inline bool IsTimeUp() const
+	{
+		return
+			(nodesBudget > 0 ? nodesSearched >= nodesBudget : steady_clock::now() >= deadline) ||
+			(cancelled && cancelled->load(memory_order_relaxed));
+	}
+};
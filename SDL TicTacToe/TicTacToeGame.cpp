@@ -1,6 +1,7 @@
 #include "TicTacToeGame.h"
 
 #pragma region C++ Includes
+#include <iostream>
 #include <cassert>
 #pragma endregion
 
@@ -14,10 +15,10 @@
 #define MONITOR_MARGIN 6
 #pragma endregion
 
-TicTacToeGame::TicTacToeGame(const SDL_Rect & viewport, ControlType crossControlType, ControlType circleControlType) :
+TicTacToeGame::TicTacToeGame(const SDL_Rect & viewport, ControlType crossControlType, ControlType circleControlType, const BoardRules & boardRules) :
 	viewport(viewport),
 	turnMonitor{turnMonitorArea},
-	gameField{gameFieldArea},
+	gameField{gameFieldArea, boardRules},
 	crossController(CreateTurnControllerForControlType(crossControlType, FG_Cross)),
 	circleController(CreateTurnControllerForControlType(circleControlType, FG_Circle))
 {
@@ -47,9 +48,18 @@ void TicTacToeGame::Update()
 {
 	if(gameField.IsGameOn())
 	{
-		//	Broadcast update to relevant components
+		//	Broadcast update to relevant components, whoever is on turn now is who may move
+		const ATurnController * movingController = dynamic_cast<const ATurnController *>(turnsScheduler.GetCurrentTurn());
 		turnsScheduler.Update();
 
+		//	A new turn means a move was made, or at least that somebody else is on turn
+		if(turnsScheduler.ConsumeTurnAdvanced())
+		{
+			RequestRedraw();
+			if(reportMoves && movingController)
+				ReportMove(movingController);
+		}
+
 		//	Define current turn
 		const ATurnController * currentTurnController = dynamic_cast<const ATurnController *>(turnsScheduler.GetCurrentTurn());
 		if(currentTurnController)
@@ -66,22 +76,29 @@ void TicTacToeGame::Update()
 		 * controllers are now bound to their turn.
 		 * Ok for this project, not for a real world scenario.
 		 */
-		turnsScheduler.StartOver();
-		gameField.Reset();
+		StartOver();
 	}
 }
 
+void TicTacToeGame::StartOver()
+{
+	turnsScheduler.StartOver();
+	gameField.Reset();
+	RequestRedraw();
+}
+
 void TicTacToeGame::PreRender(SDL_Renderer * r)
 {
 	/*
-	 * Recalculating everything every time is not wise. In
-	 * this trivial project this is not a problem but in a
-	 * real world scenario it would be wise to recalculate
-	 * only when the viewport actually changed.
+	 * Areas are only recalculated when the viewport changed,
+	 * and then components need to fit their new areas too.
 	 */
-
-	//	Update all viewport elements to accomodate viewport size
-	RefreshViewportAreas();
+	if(ConsumeLayoutDirty())
+	{
+		RefreshViewportAreas();
+		turnMonitor.InvalidateLayout();
+		gameField.InvalidateLayout();
+	}
 
 	//	Fnally, broadcast pre-render event to relevant components
 	turnMonitor.PreRender(r);
@@ -113,6 +130,47 @@ void TicTacToeGame::RefreshViewportAreas()
 	gameFieldArea.y = viewport.y + TOP_MARGIN;
 }
 
+void TicTacToeGame::ReportMove(const ATurnController * controller) const
+{
+	const char * factionName = controller->GetFactionGlyph() == FG_Cross ? "Cross" : "Circle";
+
+	//	Only the searches are worth a report, heuristics and lookups take no time
+	const CPUTurnController * cpuController = dynamic_cast<const CPUTurnController *>(controller);
+	if(cpuController)
+	{
+		const DeepeningResult & search = cpuController->GetLastSearch();
+		const ThreatResult & threatSearch = cpuController->GetLastThreatSearch();
+		if(search.bestMove > -1)
+		{
+			cout
+				<< factionName << " (CPU): depth " << search.depthReached << " in "
+				<< (int)(search.elapsedSeconds * 1000.0) << " ms, " << search.nodesSearched << " nodes, "
+				<< (long long)search.GetNodesPerSecond() << " nodes/s, ";
+			if(!IterativeDeepeningSearcher::IsDecisive(search.score))
+				cout << "score " << search.score << endl;
+			else
+				cout << (search.score > 0 ? "forced win" : "forced loss") << endl;
+		}
+		else if(threatSearch.IsWin())
+			cout
+				<< factionName << " (CPU): forced win in " << threatSearch.winDepth
+				<< " moves found by threat search in " << (int)(threatSearch.elapsedSeconds * 1000.0) << " ms, "
+				<< threatSearch.nodesSearched << " nodes" << endl;
+		return;
+	}
+
+	const MCTSTurnController * mctsController = dynamic_cast<const MCTSTurnController *>(controller);
+	if(mctsController)
+	{
+		const MCTSResult & search = mctsController->GetLastSearch();
+		cout
+			<< factionName << " (MCTS, " << search.threadsCount << " threads): "
+			<< search.playouts << " playouts in " << (int)(search.elapsedSeconds * 1000.0) << " ms, "
+			<< (long long)search.GetPlayoutsPerSecond() << " playouts/s, expected score " << (int)(search.expectedScore * 100.0f) << "%"
+			<< endl;
+	}
+}
+
 ATurnController * TicTacToeGame::CreateTurnControllerForControlType(ControlType controlType, FactionGlyph factionGlyph)
 {
 	switch(controlType)
@@ -126,6 +184,8 @@ ATurnController * TicTacToeGame::CreateTurnControllerForControlType(ControlType
 			return new CPUTurnController(Difficulty::Medium, gameField, factionGlyph);
 		case CT_CPU_Hard:
 			return new CPUTurnController(Difficulty::Hard, gameField, factionGlyph);
+		case CT_CPU_MCTS:
+			return new MCTSTurnController(gameField, factionGlyph);
 		default:
 			assert(false);	//	This shouldn't happen
 			return nullptr;
@@ -12,12 +12,16 @@
 #include "Field.h"
 #include "HumanTurnController.h"
 #include "CPUTurnController.h"
+#include "MCTSTurnController.h"
 #pragma endregion
 
 /*
  * Tic-Ttac-Toe game implementation. This class handles the game flow
  * and all its components both for update and for render, directly or
  * through its components.
+ * When asked to, it reports how the CPU found each of its moves
+ * (the controllers only keep it), so the searches can be watched
+ * while playing.
  */
 class TicTacToeGame : public IUpdatable, public IRenderable
 {
@@ -33,14 +37,20 @@ private:
 	Field gameField;
 	ATurnController * crossController;
 	ATurnController * circleController;
+	bool reportMoves = false;
 	// Constructors
 public:
-	TicTacToeGame(const SDL_Rect & viewport, ControlType crossControlType, ControlType circleControlType);
+	TicTacToeGame(const SDL_Rect & viewport, ControlType crossControlType, ControlType circleControlType, const BoardRules & boardRules = BoardRules());
 	~TicTacToeGame();
 protected:
 private:
 	// Methods
 public:
+	void StartOver();
+	__inline void SetMoveLog(MoveLog * moveLog) { gameField.SetMoveLog(moveLog); }
+	__inline const Field & GetField() const { return gameField; }
+	__inline void SetReportMoves(bool report) { reportMoves = report; }
+
 	//	IUpdatable implementation
 	void Update() override;
 
@@ -51,6 +61,7 @@ public:
 protected:
 private:
 	void RefreshViewportAreas();
+	void ReportMove(const ATurnController * controller) const;
 	ATurnController * CreateTurnControllerForControlType(ControlType controlType, FactionGlyph factionGlyph);
 };
 
@@ -11,11 +11,29 @@ enum FactionGlyph
 	FG_Circle
 };
 
+__inline FactionGlyph GetOpponentGlyph(FactionGlyph glyph)
+{
+	return glyph == FG_Cross ? FG_Circle : glyph == FG_Circle ? FG_Cross : FG_None;
+}
+
 enum ControlType
 {
 	CT_Human = 1 << 0,
 	CT_CPU = 1 << 1,
 	CT_CPU_Easy = CT_CPU | 1 << 2,
 	CT_CPU_Medium = CT_CPU | 1 << 3,
-	CT_CPU_Hard = CT_CPU | 1 << 4
+	CT_CPU_Hard = CT_CPU | 1 << 4,
+	CT_CPU_MCTS = CT_CPU | 1 << 5
+};
+
+/*
+ * Rules of the board: its size and how many glyphs in a row
+ * (horizontally, vertically or diagonally) win the game.
+ * Defaults to the classic 3x3 Tic-Tac-Toe.
+ */
+struct BoardRules
+{
+	int columns = 3;
+	int rows = 3;
+	int runLength = 3;
 };
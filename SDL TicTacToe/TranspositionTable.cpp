@@ -0,0 +1,52 @@
+#include "TranspositionTable.h"
+
+#pragma region C++ Includes
+#include <cassert>
+#include <algorithm>
+#pragma endregion
+
+TranspositionTable::TranspositionTable() :
+	entries(Bitboard::IndicesCount)
+{ }
+
+bool TranspositionTable::Probe(const TranspositionKey & key, TranspositionEntry & entry)
+{
+	const TranspositionEntry & storedEntry = entries[key.index];
+	if(storedEntry.bound == BoundType::None)
+	{
+		misses++;
+		return false;
+	}
+
+	hits++;
+
+	//	Moves are stored in the canonical orientation, bring them back to the probed board's orientation
+	entry = storedEntry;
+	if(entry.bestMove > -1)
+		entry.bestMove = (int8_t)Bitboard::InverseTransformCell(entry.bestMove, key.symmetry);
+	return true;
+}
+
+void TranspositionTable::Store(const TranspositionKey & key, int score, int bestMove, BoundType bound)
+{
+	assert(bound != BoundType::None);
+
+	TranspositionEntry & storedEntry = entries[key.index];
+	storedEntry.score = (int8_t)score;
+	storedEntry.bestMove = (int8_t)(bestMove > -1 ? Bitboard::TransformCell(bestMove, key.symmetry) : -1);
+	storedEntry.bound = bound;
+	stores++;
+}
+
+void TranspositionTable::Clear()
+{
+	fill(entries.begin(), entries.end(), TranspositionEntry());
+	ResetStats();
+}
+
+void TranspositionTable::ResetStats()
+{
+	hits = 0;
+	misses = 0;
+	stores = 0;
+}
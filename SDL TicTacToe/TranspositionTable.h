@@ -0,0 +1,94 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <cstdint>
+#include <vector>
+#pragma endregion
+
+#pragma region Game Includes
+#include "Bitboard.h"
+#pragma endregion
+
+using namespace std;
+
+/*
+ * How much a stored score can be trusted: alpha-beta may cut
+ * a search short, in that case the score is only a bound to
+ * the real value and not the real value itself.
+ */
+enum class BoundType : uint8_t
+{
+	None,
+	Exact,
+	LowerBound,
+	UpperBound
+};
+
+/*
+ * What the table remembers about a position. The best move is
+ * always returned in the orientation of the probed board,
+ * whatever orientation it was stored in.
+ */
+struct TranspositionEntry
+{
+	int8_t score = 0;
+	int8_t bestMove = -1;
+	BoundType bound = BoundType::None;
+};
+
+/*
+ * Identifies a position in the table: the canonical index of
+ * the board and the symmetry that turns the board into its
+ * canonical variant, needed to rotate moves back and forth.
+ * Computing a key is the most expensive part of a lookup, so
+ * it's computed once and reused for probing and storing.
+ */
+struct TranspositionKey
+{
+	BoardIndex index;
+	int symmetry;
+};
+
+/*
+ * Memory of the searches, so positions reached through
+ * different move orders (transpositions) or that are just
+ * rotated/mirrored versions of each other are searched only
+ * once.
+ * Tic-Tac-Toe is small enough to have one slot for every
+ * possible canonical index, so there are no collisions and
+ * no replacement policy to worry about.
+ *
+ * The table doesn't depend on any specific searcher, anybody
+ * who needs to remember position values can use one.
+ */
+class TranspositionTable
+{
+	// Fields
+public:
+protected:
+private:
+	vector<TranspositionEntry> entries;
+	unsigned long long hits = 0;
+	unsigned long long misses = 0;
+	unsigned long long stores = 0;
+	// Constructors
+public:
+	TranspositionTable();
+protected:
+private:
+	// Methods
+public:
+	__inline static TranspositionKey MakeKey(const Bitboard & board) { TranspositionKey key; key.index = board.GetCanonicalIndex(&key.symmetry); return key; }
+	bool Probe(const TranspositionKey & key, TranspositionEntry & entry);
+	void Store(const TranspositionKey & key, int score, int bestMove, BoundType bound);
+	void Clear();
+
+	//	Statistics
+	__inline unsigned long long GetHits() const { return hits; }
+	__inline unsigned long long GetMisses() const { return misses; }
+	__inline unsigned long long GetStores() const { return stores; }
+	__inline float GetHitRate() const { return hits + misses > 0 ? (float)hits / (float)(hits + misses) : 0.0f; }
+	void ResetStats();
+protected:
+private:
+};
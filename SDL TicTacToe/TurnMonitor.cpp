@@ -18,9 +18,10 @@ TurnMonitor::TurnMonitor(const SDL_Rect & area, FactionGlyph initialGlyph) :
 	CalculateMoitorMetrics();
 }
 
-void TurnMonitor::PreRender(SDL_Renderer * r)
+void TurnMonitor::PreRender(SDL_Renderer * /* r */)
 {
-	CalculateMoitorMetrics();
+	if(ConsumeLayoutDirty())
+		CalculateMoitorMetrics();
 }
 
 void TurnMonitor::Render(SDL_Renderer * r) const
@@ -48,6 +48,7 @@ void TurnsScheduler::StartOver()
 
 	//	Begin the first turn
 	currentTurn->OnTurnBegan();
+	turnAdvanced = true;
 }
 
 void TurnsScheduler::Update()
@@ -109,4 +110,5 @@ void TurnsScheduler::AdvanceTurn()
 	//	Notify the current turn that its turn just began
 	assert(currentTurn);	//	This shouldn't ever trigger, it would mean that an element in the vector became nullptr and it's unlikely to happen
 	currentTurn->OnTurnBegan();
+	turnAdvanced = true;
 }
@@ -27,6 +27,7 @@ protected:
 private:
 	vector<ITurnsReceiver * > turns;
 	ITurnsReceiver * currentTurn = nullptr;
+	bool turnAdvanced = false;
 	// Constructors
 public:
 protected:
@@ -37,6 +38,8 @@ public:
 	void RemoveTurn(ITurnsReceiver * turnToRemove);
 	void StartOver();
 	const ITurnsReceiver * GetCurrentTurn() const { return currentTurn; }
+	//	Whether a turn began since the last call (the board or the faction on turn changed)
+	__inline bool ConsumeTurnAdvanced() { const bool turnAdvancedCache = turnAdvanced; turnAdvanced = false; return turnAdvancedCache; }
 
 	//	IUpdatable implementation
 	void Update() override;
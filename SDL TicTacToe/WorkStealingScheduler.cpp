@@ -0,0 +1,136 @@
+#include "WorkStealingScheduler.h"
+
+#pragma region Engine Includes
+#include "ThreadPool.h"
+#pragma endregion
+
+#ifndef __EMSCRIPTEN__
+//	Scheduler and queue of the calling thread, when it's a worker
+thread_local const WorkStealingScheduler * currentScheduler = nullptr;
+thread_local int currentWorker = -1;
+#endif
+
+WorkStealingScheduler::WorkStealingScheduler(function<void(int)> handler, int workersCount) :
+	handler(move(handler)),
+	workersCount(workersCount > 0 ? workersCount : ThreadPool::GetHardwareThreadsCount())
+{
+#ifdef __EMSCRIPTEN__
+	this->workersCount = 1;
+#else
+	for(int worker = 0; worker < this->workersCount; worker++)
+		queues.emplace_back(new WorkerQueue());
+	for(int worker = 0; worker < this->workersCount; worker++)
+		threads.emplace_back(&WorkStealingScheduler::WorkerLoop, this, worker);
+#endif
+}
+
+WorkStealingScheduler::~WorkStealingScheduler()
+{
+#ifndef __EMSCRIPTEN__
+	//	Tasks still queued are dropped
+	{
+		lock_guard<mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	workAvailable.notify_all();
+	for(thread & workerThread : threads)
+		workerThread.join();
+#endif
+}
+
+void WorkStealingScheduler::Submit(int task)
+{
+#ifdef __EMSCRIPTEN__
+	//	Tasks submitted by a running task wait for it to be over
+	tasks.push_back(task);
+	if(running)
+		return;
+
+	running = true;
+	while(!tasks.empty())
+	{
+		const int nextTask = tasks.front();
+		tasks.pop_front();
+		handler(nextTask);
+	}
+	running = false;
+#else
+	const int queue = currentScheduler == this ? currentWorker : (int)(nextQueue++ % (unsigned int)workersCount);
+	{
+		lock_guard<mutex> lock(queues[queue]->queueMutex);
+		queues[queue]->tasks.push_back(task);
+	}
+
+	/*
+	 * A worker going to sleep first counts itself as sleeping,
+	 * then checks for tasks: either it sees this task, or this
+	 * thread sees it sleeping and wakes it up. Locking the mutex
+	 * makes sure it's not between its check and its wait.
+	 */
+	queuedTasks++;
+	if(sleepingWorkers.load() > 0)
+	{
+		{
+			lock_guard<mutex> lock(sleepMutex);
+		}
+		workAvailable.notify_one();
+	}
+#endif
+}
+
+#ifndef __EMSCRIPTEN__
+void WorkStealingScheduler::WorkerLoop(int worker)
+{
+	currentScheduler = this;
+	currentWorker = worker;
+
+	while(true)
+	{
+		int task;
+		if(PopTask(worker, task))
+		{
+			handler(task);
+			continue;
+		}
+
+		unique_lock<mutex> lock(sleepMutex);
+		sleepingWorkers++;
+		workAvailable.wait(lock, [this] { return stopping || queuedTasks.load() > 0; });
+		sleepingWorkers--;
+		if(stopping)
+			return;
+	}
+}
+
+bool WorkStealingScheduler::PopTask(int worker, int & task)
+{
+	//	Oldest task of its own queue first
+	{
+		WorkerQueue & ownQueue = *queues[worker];
+		lock_guard<mutex> lock(ownQueue.queueMutex);
+		if(!ownQueue.tasks.empty())
+		{
+			task = ownQueue.tasks.front();
+			ownQueue.tasks.pop_front();
+			queuedTasks--;
+			return true;
+		}
+	}
+
+	//	Then the latest task of the others, starting from the next one so victims are spread
+	for(int offset = 1; offset < workersCount; offset++)
+	{
+		WorkerQueue & victimQueue = *queues[(worker + offset) % workersCount];
+		lock_guard<mutex> lock(victimQueue.queueMutex);
+		if(!victimQueue.tasks.empty())
+		{
+			task = victimQueue.tasks.back();
+			victimQueue.tasks.pop_back();
+			queuedTasks--;
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
@@ -0,0 +1,87 @@
+#pragma once
+
+#pragma region C++ Includes
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#ifndef __EMSCRIPTEN__
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+#pragma endregion
+
+using namespace std;
+
+/*
+ * Pool of worker threads running many small independent tasks
+ * (e.g. stepping one of thousands of matches), each one given
+ * by an integer and handed to the same handler, so submitting
+ * a task never allocates.
+ *
+ * Every worker has a queue of its own: tasks submitted by a
+ * worker go to its own queue, while tasks submitted from other
+ * threads are dealt to the queues in turn. A worker picks the
+ * oldest task of its queue first, so under a steady stream of
+ * tasks none waits longer than the queue ahead of it. A worker
+ * with an empty queue steals the latest task of the others, at
+ * the other end from the owner, so work spreads by itself over
+ * the cores with no central queue to fight for, and workers
+ * only sleep when there is no task anywhere.
+ *
+ * The same task may be submitted again while it's running, the
+ * handler must be ready for two workers running it at once.
+ *
+ * Web builds have no threads, there tasks run on the thread
+ * submitting them, one after the other.
+ */
+class WorkStealingScheduler
+{
+	// Fields
+public:
+protected:
+private:
+	function<void(int)> handler;
+	int workersCount;
+#ifndef __EMSCRIPTEN__
+	struct WorkerQueue
+	{
+		mutex queueMutex;
+		deque<int> tasks;
+		char padding[64];	//	Queues allocated one after the other don't share cache lines
+	};
+	vector<unique_ptr<WorkerQueue>> queues;
+	vector<thread> threads;
+	atomic<int> queuedTasks{0};
+	atomic<int> sleepingWorkers{0};
+	atomic<unsigned int> nextQueue{0};
+	mutex sleepMutex;
+	condition_variable workAvailable;
+	bool stopping = false;
+#else
+	deque<int> tasks;
+	bool running = false;
+#endif
+	// Constructors
+public:
+	//	Zero or less for one worker per hardware thread
+	WorkStealingScheduler(function<void(int)> handler, int workersCount = 0);
+	~WorkStealingScheduler();
+	//	Threads are owned, no copies
+	WorkStealingScheduler(const WorkStealingScheduler &) = delete;
+	WorkStealingScheduler & operator=(const WorkStealingScheduler &) = delete;
+protected:
+private:
+	// Methods
+public:
+	__inline int GetWorkersCount() const { return workersCount; }
+	void Submit(int task);
+protected:
+private:
+#ifndef __EMSCRIPTEN__
+	void WorkerLoop(int worker);
+	bool PopTask(int worker, int & task);
+#endif
+};
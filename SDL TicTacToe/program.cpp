@@ -3,6 +3,11 @@
 #include <vector>
 #include <cmath>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <climits>
 #pragma endregion
 
 #pragma region SDL Includes
@@ -12,11 +17,20 @@
 #pragma region Engine Includes
 #include "Input.h"
 #include "Random.h"
+#include "Clock.h"
+#include "FrameProfiler.h"
+#include "FrameTimeGraph.h"
+#include "FramePacer.h"
+#include "JobSystem.h"
 #pragma endregion
 
 #pragma region Game Includes
 #include "Tokens.h"
 #include "TicTacToeGame.h"
+#include "MoveLog.h"
+#include "CommandLine.h"
+#include "Tablebase.h"
+#include "Drawing.h"
 #pragma endregion
 
 #pragma region Emscripten Includes
@@ -44,7 +58,7 @@ using namespace std::chrono;
 #define VIEWPORT_W 800
 #define VIEWPORT_H 450
 #define VIEWPORT_MODE SDL_WINDOW_RESIZABLE
-#elif
+#else
 #define VIEWPORT_W 1920
 #define VIEWPORT_H 1080
 #define VIEWPORT_MODE SDL_WINDOW_FULLSCREEN
@@ -52,8 +66,9 @@ using namespace std::chrono;
 #endif
 #define SDL_INIT_MODE (SDL_INIT_VIDEO | SDL_INIT_AUDIO)
 
-#define TARGET_FPS 60
-#define TARGET_FRAME_TIME (1000 / TARGET_FPS)
+#define TARGET_FPS 60	//	When the display's refresh rate is unknown
+#define SIMULATION_HZ 60
+#define MAX_FRAME_MILLIS 250	//	Longer frames (e.g. while dragging the window) are not caught up with in full
 
 #define RENDER_CLEAR_COLOR 10, 10, 10, 255
 
@@ -70,6 +85,31 @@ using namespace std::chrono;
 #define CLI_VAL_CPU_EASY "easy"
 #define CLI_VAL_CPU_MEDIUM "medium"
 #define CLI_VAL_CPU_HARD "hard"
+#define CLI_VAL_CPU_MCTS "mcts"	//	Monte Carlo tree search, for bigger boards
+#define CLI_KEY_BOARD "-board"	//	Followed by <columns>x<rows> or <columns>x<rows>x<run length>
+#define CLI_KEY_HEADLESS "--headless"	//	Runs CPU vs CPU games with no window, as fast as possible
+#define CLI_KEY_GAMES "--games"	//	Followed by the number of games to run in headless mode
+#define CLI_KEY_VERBOSE "--verbose"	//	Reports how the CPU found each move in headless mode too, as the window always does
+#define DEFAULT_HEADLESS_GAMES 1000
+#define CLI_KEY_SEED "--seed"	//	Followed by the seed for random numbers, to play the same games again
+#define CLI_KEY_RECORD "--record"	//	Followed by the path where to save the moves of the session
+#define CLI_KEY_REPLAY "--replay"	//	Followed by the path of a recorded session to play again and check
+#define CLI_KEY_PROFILE "--profile"	//	Shows the frame time graph (F3 toggles it)
+#define CLI_KEY_PROFILE_CSV "--profile-csv"	//	Followed by the path where to save frame times as CSV on exit
+#define CLI_KEY_PROFILE_TRACE "--profile-trace"	//	Followed by the path where to save frame times as a Chrome trace on exit
+#define CLI_KEY_RENDER_ON_CHANGE "--render-on-change"	//	Only draws a frame when something changed, idling in between
+#define CLI_KEY_SIMULATION_HZ "--sim-hz"	//	Followed by the number of simulation steps per second
+#define CLI_KEY_FPS "--fps"	//	Followed by the target frame rate, the display's refresh rate by default
+#define CLI_KEY_VSYNC "--vsync"	//	Waits for the display's vertical sync on present, frames are not paced otherwise
+#define CLI_KEY_CPU_TIME "--cpu-time"	//	Followed by the most milliseconds the hard CPU searches for each move, on boards other than the classic one
+#define CLI_KEY_CPU_DEPTH "--cpu-depth"	//	Followed by the most plies the hard CPU searches for each move, on boards other than the classic one, 0 for no limit
+#define CLI_KEY_CPU_THREADS "--cpu-threads"	//	Followed by the number of threads the hard CPU searches on, helpers sharing its transposition table, 0 for one per core
+#define CLI_KEY_CPU_TABLE "--cpu-table"	//	Followed by the megabytes of the transposition table of the hard CPU, 0 for none
+#define CLI_KEY_TABLEBASE "--tablebase"	//	Followed by the path of a tablebase, the hard CPU plays perfectly on its board (see the tablebase tool)
+#define CLI_KEY_MCTS_TIME "--mcts-time"	//	Followed by the milliseconds the MCTS CPU thinks for each move
+#define CLI_KEY_MCTS_THREADS "--mcts-threads"	//	Followed by the number of threads the MCTS CPU thinks on, 0 (the default) for one per core
+#define CLI_KEY_MCTS_PLAYOUTS "--mcts-playouts"	//	Followed by the maximum number of playouts for each move of the MCTS CPU, 0 (the default) for no limit
+#define CLI_KEY_MCTS_EXPLORATION "--mcts-exploration"	//	Followed by the UCT exploration constant of the MCTS CPU
 #pragma endregion
 
 #define AI_TIME 250
@@ -85,8 +125,15 @@ typedef struct
 typedef struct
 {
 	bool closeRequested;
+	bool renderOnChange;
 	vector<IUpdatable *> updateQueue;
 	vector<IRenderable *> renderQueue;
+	FrameProfiler profiler;
+	FrameTimeGraph * frameTimeGraph;
+	FramePacer pacer;
+	steady_clock::duration simulationStep;
+	steady_clock::duration simulationLag;
+	steady_clock::time_point lastFrameTime;
 } EngineData;
 typedef struct
 {
@@ -101,10 +148,12 @@ typedef struct
 #pragma endregion
 
 //	Forward declarations
-void RefreshViewportSize();
+bool RefreshViewportSize();
 int SystemSetup();
 void MainLoop();
 void SystemShutdown();
+void HeadlessSetup();
+void HeadlessLoop(int gamesCount);
 void OverrideControl(int argc, char * argv[], const char * argCheck, ControlType & control);
 
 //	Prepare a global context for the main loop and the main function
@@ -119,10 +168,23 @@ int main(int argc, char *argv[])
 	 * the main elements that will make our game
 	 * work, such as SDL itself, the game window
 	 * and the renderer.
+	 * In headless mode there's nothing to show,
+	 * so no video at all: we only need the game
+	 * logic and a virtual clock to drive it.
 	 */
-	const int setupResult = SystemSetup();
-	if(setupResult != 0)
-		return setupResult;
+#ifndef __EMSCRIPTEN__
+	const bool headless = CommandLine::HasFlag(argc, argv, CLI_KEY_HEADLESS);
+#else
+	const bool headless = false;
+#endif
+	if(headless)
+		HeadlessSetup();
+	else
+	{
+		const int setupResult = SystemSetup();
+		if(setupResult != 0)
+			return setupResult;
+	}
 #pragma endregion
 
 #pragma region Gameplay Setup
@@ -135,17 +197,191 @@ int main(int argc, char *argv[])
 	OverrideControl(argc, argv, CLI_KEY_CROSS, crossControlType);
 	OverrideControl(argc, argv, CLI_KEY_CIRCLE_FULL, circleControlType);
 	OverrideControl(argc, argv, CLI_KEY_CIRCLE, circleControlType);
+
+	//	Prepare board rules, classic Tic-Tac-Toe unless overridden by command line arguments
+	BoardRules boardRules;
+	CommandLine::OverrideBoardRules(argc, argv, CLI_KEY_BOARD, boardRules);
+
+	//	Prepare the iterative deepening search, for the hard CPU on boards other than the classic one
+	DeepeningSettings deepeningSettings;
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_CPU_TIME, deepeningSettings.timeBudgetMillis);
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_CPU_DEPTH, deepeningSettings.maxDepth, 0);
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_CPU_THREADS, deepeningSettings.threadsCount, 0);
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_CPU_TABLE, deepeningSettings.tableMegabytes, 0);
+
+	//	The threat search the hard CPU tries first has no command line arguments, but replays still need its settings
+	ThreatSettings threatSettings;
+
+	//	Prepare the Monte Carlo tree search, for the factions playing with it
+	MCTSSettings mctsSettings;
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_MCTS_TIME, mctsSettings.timeBudgetMillis);
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_MCTS_THREADS, mctsSettings.threadsCount, 0);
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_MCTS_PLAYOUTS, mctsSettings.maxPlayouts, 0);
+	CommandLine::OverrideFactor(argc, argv, CLI_KEY_MCTS_EXPLORATION, mctsSettings.exploration);
+
+	//	Prepare the seed, random unless overridden by command line arguments
+	uint64_t seed = Random::GetSeed();
+	CommandLine::OverrideSeed(argc, argv, CLI_KEY_SEED, seed);
+
+	//	A replay plays with the seed and settings of the recorded session
+	const char * recordPath = CommandLine::FindArgValue(argc, argv, CLI_KEY_RECORD);
+	const char * replayPath = CommandLine::FindArgValue(argc, argv, CLI_KEY_REPLAY);
+	MoveLog replayedLog;
+	if(replayPath)
+	{
+		if(!replayedLog.Load(replayPath))
+		{
+			cout << "Couldn't load moves to replay from " << replayPath << endl;
+			SystemShutdown();
+			return -1;
+		}
+
+		seed = replayedLog.GetSeed();
+		boardRules = replayedLog.GetRules();
+		crossControlType = replayedLog.GetCrossControlType();
+		circleControlType = replayedLog.GetCircleControlType();
+		deepeningSettings = replayedLog.GetDeepeningSettings();
+		threatSettings = replayedLog.GetThreatSettings();
+		mctsSettings = replayedLog.GetMCTSSettings();
+	}
+
+	//	Controllers take the settings in place when they're created, along with the game
+	CPUTurnController::SetDefaultSettings(deepeningSettings);
+	CPUTurnController::SetDefaultThreatSettings(threatSettings);
+	MCTSTurnController::SetDefaultSettings(mctsSettings);
+
+	//	In the window the easier CPUs take their time, rather than moving the very frame the turn begins
+	CPUTurnController::SetThinkingDelay(!headless);
+
+	//	Nobody can click on a headless game, and clicks can't be replayed
+	if((headless || replayPath) && (crossControlType == CT_Human || circleControlType == CT_Human))
+	{
+		cout << "Headless mode and replays need both factions to be played by the CPU (see " << CLI_KEY_CROSS << " and " << CLI_KEY_CIRCLE << ")" << endl;
+		SystemShutdown();
+		return -1;
+	}
+
+	//	Same seed, same games: report it so any session can be played again
+	Random::Seed(seed);
+	cout << "Seed: " << seed << endl;
+
+	//	The tablebase is mapped for the whole session, it's only looked up when playing on its board
+	Tablebase tablebase;
+	const char * tablebasePath = CommandLine::FindArgValue(argc, argv, CLI_KEY_TABLEBASE);
+	if(tablebasePath)
+	{
+		if(!tablebase.Open(tablebasePath))
+			cout << "Couldn't open the tablebase " << tablebasePath << endl;
+		else if(!tablebase.Covers(boardRules))
+			cout << "Ignoring the tablebase " << tablebasePath << ", it's for another board" << endl;
+		else
+			CPUTurnController::SetTablebase(&tablebase);
+	}
+
 	ctx.game.ticTacToeGame = new TicTacToeGame
 	{
 		ctx.system.viewport,
 		crossControlType,
-		circleControlType
+		circleControlType,
+		boardRules
 	};
 
+	//	Keep track of the moves, to save them or to check them against the replayed ones
+	MoveLog moveLog(seed, boardRules, crossControlType, circleControlType, deepeningSettings, threatSettings, mctsSettings);
+	if(recordPath || replayPath)
+		ctx.game.ticTacToeGame->SetMoveLog(&moveLog);
+
+	//	Thousands of headless games would bury the summary under the reports
+	ctx.game.ticTacToeGame->SetReportMoves(!headless || CommandLine::HasFlag(argc, argv, CLI_KEY_VERBOSE));
+
 	ctx.engine.updateQueue.push_back(ctx.game.ticTacToeGame);
 	ctx.engine.renderQueue.push_back(ctx.game.ticTacToeGame);
 #pragma endregion
 
+#pragma region Frame Pacing Setup
+	/*
+	 * The simulation (events and updates) runs in fixed steps,
+	 * at its own rate, whatever the frame rate: frames just
+	 * show the latest step. This keeps the game logic behaving
+	 * the same on any display, and lets rendering follow the
+	 * display's refresh rate (e.g. 120 or 144 Hz) without the
+	 * logic running any faster.
+	 *
+	 * Frames are paced at the display's refresh rate, unless
+	 * presenting waits for VSync already: with adaptive sync
+	 * (G-Sync/FreeSync) displays, where VSync isn't needed,
+	 * the pacer's regular schedule is what keeps frames
+	 * evenly spaced.
+	 */
+	int simulationHz = SIMULATION_HZ;
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_SIMULATION_HZ, simulationHz);
+	ctx.engine.simulationStep = duration_cast<steady_clock::duration>(duration<double>(1.0 / simulationHz));
+
+	int displayRefreshRate = 0;
+	bool vsync = false;
+#ifndef __EMSCRIPTEN__
+	if(!headless)
+	{
+		SDL_DisplayMode displayMode;
+		if(SDL_GetWindowDisplayMode(ctx.system.window, &displayMode) == 0)
+			displayRefreshRate = displayMode.refresh_rate;
+
+		vsync = CommandLine::HasFlag(argc, argv, CLI_KEY_VSYNC);
+		if(vsync && SDL_RenderSetVSync(ctx.system.r, 1) != 0)
+		{
+			cout << "Couldn't enable VSync: " << SDL_GetError() << endl;
+			vsync = false;
+		}
+	}
+#endif
+	int targetFPS = vsync ? 0 : (displayRefreshRate > 0 ? displayRefreshRate : TARGET_FPS);
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_FPS, targetFPS);
+	ctx.engine.pacer.SetTargetFPS(targetFPS);
+#ifdef FRAME_SKIP
+	ctx.engine.pacer.SetFrameSkip(true);
+#endif
+
+	//	A frame is expected to take a period of either the target frame rate or the display's
+	const int frameRate = targetFPS > 0 ? targetFPS : (displayRefreshRate > 0 ? displayRefreshRate : TARGET_FPS);
+	const float frameBudgetMillis = 1000.0f / frameRate;
+#pragma endregion
+
+#pragma region Profiling Setup
+	/*
+	 * Frame times are only captured when asked for, either to
+	 * be shown or to be saved on exit. The graph is drawn on
+	 * top of everything else, so it goes last in the queues.
+	 * Headless runs have no frames to profile.
+	 */
+	const bool showFrameTimeGraph = CommandLine::HasFlag(argc, argv, CLI_KEY_PROFILE);
+	const char * profileCSVPath = CommandLine::FindArgValue(argc, argv, CLI_KEY_PROFILE_CSV);
+	const char * profileTracePath = CommandLine::FindArgValue(argc, argv, CLI_KEY_PROFILE_TRACE);
+	if(!headless && (showFrameTimeGraph || profileCSVPath || profileTracePath))
+	{
+		ctx.engine.profiler.Enable();
+		ctx.engine.frameTimeGraph = new FrameTimeGraph(ctx.engine.profiler, ctx.system.viewport, frameBudgetMillis, showFrameTimeGraph);
+
+		ctx.engine.updateQueue.push_back(ctx.engine.frameTimeGraph);
+		ctx.engine.renderQueue.push_back(ctx.engine.frameTimeGraph);
+	}
+#pragma endregion
+
+#pragma region Presentation Mode
+	/*
+	 * By default a frame is drawn every iteration, at the target
+	 * frame rate. Nothing on screen moves by itself though: it
+	 * only changes on input, when a turn advances or on resize,
+	 * so the main loop can just sleep until one of those happens
+	 * and save the CPU and GPU time of drawing the same frame
+	 * over and over.
+	 */
+	ctx.engine.renderOnChange = !headless && CommandLine::HasFlag(argc, argv, CLI_KEY_RENDER_ON_CHANGE);
+
+	//	Simulation time starts flowing now
+	ctx.engine.simulationLag = steady_clock::duration::zero();
+	ctx.engine.lastFrameTime = steady_clock::now();
+#pragma endregion
+
 #pragma region Main Loop
 	/*
 	 * Just a couple of lines, here the program will
@@ -156,8 +392,16 @@ int main(int argc, char *argv[])
 #ifdef __EMSCRIPTEN__
 	emscripten_set_main_loop(MainLoop, 0, 1);
 #else
-	while(!ctx.engine.closeRequested)
-		MainLoop();
+	if(headless)
+	{
+		int gamesCount = replayPath ? replayedLog.GetGamesCount() : DEFAULT_HEADLESS_GAMES;
+		if(!replayPath)
+			CommandLine::OverrideCount(argc, argv, CLI_KEY_GAMES, gamesCount);
+		HeadlessLoop(gamesCount);
+	}
+	else
+		while(!ctx.engine.closeRequested)
+			MainLoop();
 #endif
 #pragma endregion
 
@@ -181,11 +425,48 @@ int main(int argc, char *argv[])
 #endif
 #pragma endregion
 
-	return 0;
+#pragma region Profiling Results
+	//	Save the captured frame times, if asked to
+	if(profileCSVPath && !ctx.engine.profiler.SaveCSV(profileCSVPath))
+		cout << "Couldn't save frame times to " << profileCSVPath << endl;
+	if(profileTracePath && !ctx.engine.profiler.SaveChromeTrace(profileTracePath))
+		cout << "Couldn't save frame times to " << profileTracePath << endl;
+#pragma endregion
+
+#pragma region Session Log
+	/*
+	 * Save the moves of the session and, when replaying,
+	 * report the first move that differs from the recorded
+	 * session: same seed and same settings must lead to the
+	 * very same moves, on any build.
+	 */
+	int exitCode = 0;
+	if(recordPath && !moveLog.Save(recordPath))
+	{
+		cout << "Couldn't save moves to " << recordPath << endl;
+		exitCode = -1;
+	}
+	if(replayPath)
+	{
+		int divergentGame = 0;
+		int divergentMove = 0;
+		if(MoveLog::FindDivergence(replayedLog, moveLog, divergentGame, divergentMove))
+		{
+			cout << "Replay diverged at game " << divergentGame + 1 << ", move " << divergentMove + 1 << endl;
+			exitCode = 1;
+		}
+		else
+			cout << "Replay matches the recorded session (" << moveLog.GetGamesCount() << " games)" << endl;
+	}
+#pragma endregion
+
+	return exitCode;
 }
 
-void RefreshViewportSize()
+bool RefreshViewportSize()
 {
+	const SDL_Rect previousViewport = ctx.system.viewport;
+
 #ifndef __EMSCRIPTEN__
 #ifndef _DEBUG
 	SDL_DisplayMode displayMode;
@@ -213,6 +494,8 @@ void RefreshViewportSize()
 	//	When targetting webgl, try to always match the canvas' size
 	emscripten_get_canvas_element_size(HTML_CANVAS_SELECTOR, &ctx.system.viewport.w, &ctx.system.viewport.h);
 #endif
+
+	return ctx.system.viewport.w != previousViewport.w || ctx.system.viewport.h != previousViewport.h;
 }
 
 int SystemSetup()
@@ -241,6 +524,9 @@ int SystemSetup()
 		return -1;
 	}
 
+	//	The window may not get the size it asked for (e.g. fullscreen), from now on it's resize events that tell
+	RefreshViewportSize();
+
 	//	Get or create a rendeer for future render operations
 	ctx.system.r = SDL_GetRenderer(ctx.system.window);
 	if(!ctx.system.r)
@@ -270,27 +556,59 @@ int SystemSetup()
 
 void MainLoop()
 {
-#pragma region Prepare FPS Regulation
+#pragma region Wait For Changes
 	/*
-	 * To keep a steady frame rate, we need to know
-	 * how long it takes for a frame to make all
-	 * calculations and render and then wait for the
-	 * target frame time.
-	 * To do so, when the frame starts, i.e. when
-	 * entering the main 
-	 * 
-	 * When building for webgl, we let the browser decide
-	 * the frame rate, which will typically match the
-	 * monitor's refresh rate, so we're skipping all the
-	 * framerate regulation stuff when targetting webgl.loop, we store the precise
-	 * time.
+	 * In render-on-change mode nothing can change until an event
+	 * arrives (a CPU done thinking in the background sends one
+	 * too) or until a pending timer expires (whoever waits for a
+	 * given time requests a wake-up), so block until whichever
+	 * comes first. Events are
+	 * left in the queue for the input loop.
+	 * The wake-up request is served here: whoever is still waiting
+	 * requests it again during the next update.
+	 * Time spent idling is not simulation time to catch up with,
+	 * so a single step runs for what woke the loop up.
+	 *
+	 * The browser calls this function on its own schedule, and
+	 * blocking it would freeze the page, so webgl builds don't wait
+	 * and only skip drawing.
 	 */
 #ifndef __EMSCRIPTEN__
-	steady_clock::time_point frameStart = high_resolution_clock::now();
+	if(ctx.engine.renderOnChange)
+	{
+		int timeoutMillis = -1;	//	No pending timers, only an event can change something
+		if(Clock::Get().HasWakeUpRequest())
+		{
+			const Uint64 now = Clock::Get().GetTicks();
+			const Uint64 wakeUp = Clock::Get().GetNextWakeUp();
+			timeoutMillis = wakeUp > now ? (int)min<Uint64>(wakeUp - now, INT_MAX) : 0;
+		}
+		SDL_WaitEventTimeout(nullptr, timeoutMillis);
+		Clock::Get().AdvanceToNextWakeUp();
+
+		ctx.engine.simulationLag = ctx.engine.simulationStep;
+		ctx.engine.lastFrameTime = steady_clock::now();
+		ctx.engine.pacer.Reset();
+	}
 #endif
 #pragma endregion
 
-#pragma region Events/Input Loop
+#pragma region Frame Timing
+	/*
+	 * The real time elapsed since the previous frame is what the
+	 * simulation lags behind: it's consumed in fixed steps below,
+	 * and what's left, less than a step, carries over to the next
+	 * frame. A frame that took very long doesn't make the
+	 * simulation run many steps in a row, which would only make
+	 * the next frame even longer.
+	 */
+	ctx.engine.profiler.BeginFrame();
+	const steady_clock::time_point frameStart = steady_clock::now();
+	ctx.engine.simulationLag += min<steady_clock::duration>(frameStart - ctx.engine.lastFrameTime, milliseconds(MAX_FRAME_MILLIS));
+	ctx.engine.lastFrameTime = frameStart;
+#pragma endregion
+
+#pragma region Simulation Loop (Events/Input and Logic)
 	/*
 	 * Here we decided to move all the event loop to a
 	 * dedicated class, the Input class.
@@ -298,68 +616,125 @@ void MainLoop()
 	 * scope and the goals of the project.
 	 * Read notes above the Input::PollEvents method for
 	 * more considerations.
+	 *
+	 * Events are polled once per step, not once per frame:
+	 * input states (e.g. pressed this iteration) are relative
+	 * to the previous poll, so this way every update sees each
+	 * press exactly once, however many steps a frame runs.
+	 * Frames running no step at all leave events in the queue
+	 * for the next step.
+	 * What the render loop needs to know is collected across
+	 * the steps of the frame.
 	 */
+	bool eventsReceived = false;
+	bool windowResized = false;
+	bool renderTargetsReset = false;
+	while(ctx.engine.simulationLag >= ctx.engine.simulationStep && !ctx.engine.closeRequested)
+	{
+		Input::Get().PollEvents();
+		eventsReceived = eventsReceived || Input::Get().WereEventsReceived();
+		windowResized = windowResized || Input::Get().WasWindowResized();
+		renderTargetsReset = renderTargetsReset || Input::Get().WereRenderTargetsReset();
 
-	Input::Get().PollEvents();
+		//	Handle quit requests
+		if(Input::Get().WasQuitRequested())
+			ctx.engine.closeRequested = true;
 
-	//	Handle quit requests
-	if(Input::Get().WasQuitRequested())
-		ctx.engine.closeRequested = true;
-#pragma endregion
+		ctx.engine.profiler.EndPhase(FP_PollEvents);
 
-#pragma region Update Loop (Logic)
-	for(IUpdatable *& updatable : ctx.engine.updateQueue)
-		updatable->Update();
+		for(IUpdatable *& updatable : ctx.engine.updateQueue)
+			updatable->Update();
+
+		ctx.engine.simulationLag -= ctx.engine.simulationStep;
+		ctx.engine.profiler.EndPhase(FP_Update);
+	}
 #pragma endregion
 
 #pragma region Render Loop
-	//	Adapt viewport to the window
-	RefreshViewportSize();
+	/*
+	 * Adapt viewport to the window, only when its size changed:
+	 * native windows report it with an event, while the canvas
+	 * of a web page can be resized by the page without SDL
+	 * noticing, so its size is checked every frame (a cheap
+	 * check compared to laying everything out again).
+	 * Renderables lay themselves out again on PreRender.
+	 */
+#ifndef __EMSCRIPTEN__
+	const bool viewportChanged = windowResized && RefreshViewportSize();
+#else
+	const bool viewportChanged = RefreshViewportSize();
+#endif
+	//	Lost render targets are recreated along with the layout, so they're handled the same way
+	if(viewportChanged || renderTargetsReset)
+		for(IRenderable * const & renderable : ctx.engine.renderQueue)
+			renderable->InvalidateLayout();
 
-	//	Send a pre-render message to all subscribers so they can prepare for rendering
+	/*
+	 * Draw only if something changed, in render-on-change mode:
+	 * any event may have changed something (a hover, a window
+	 * uncovered...), otherwise it's up to the renderables to
+	 * tell. Requests are consumed in any mode, so they don't
+	 * pile up.
+	 */
+	bool redraw = !ctx.engine.renderOnChange || eventsReceived;
 	for(IRenderable * const & renderable : ctx.engine.renderQueue)
-		renderable->PreRender(ctx.system.r);
-
-	//	Let's clear the canvas before drawing a new frame
-	SDL_SetRenderDrawColor(ctx.system.r, RENDER_CLEAR_COLOR);
-	SDL_RenderClear(ctx.system.r);
-
-	//	Draw all renderables to the back buffer (Render is a const function)
-	for(const IRenderable * const & renderable : ctx.engine.renderQueue)
-		renderable->Render(ctx.system.r);
+		if(renderable->ConsumeRedrawRequest())
+			redraw = true;
 
-	//	Swap front and back buffer to show results of the render
-	SDL_RenderPresent(ctx.system.r);
+	if(redraw)
+	{
+		/*
+		 * Frames fall between simulation steps: tell renderables
+		 * how far into the next step this frame is, so anything
+		 * moving can be drawn where it would be by now instead
+		 * of stuttering from step to step.
+		 */
+		const float interpolation = duration<float>(ctx.engine.simulationLag) / duration<float>(ctx.engine.simulationStep);
+		for(IRenderable * const & renderable : ctx.engine.renderQueue)
+			renderable->Interpolate(interpolation);
+
+		//	Send a pre-render message to all subscribers so they can prepare for rendering
+		for(IRenderable * const & renderable : ctx.engine.renderQueue)
+			renderable->PreRender(ctx.system.r);
+		ctx.engine.profiler.EndPhase(FP_PreRender);
+
+		//	Let's clear the canvas before drawing a new frame
+		SDL_SetRenderDrawColor(ctx.system.r, RENDER_CLEAR_COLOR);
+		SDL_RenderClear(ctx.system.r);
+
+		//	Draw all renderables to the back buffer (Render is a const function)
+		for(const IRenderable * const & renderable : ctx.engine.renderQueue)
+			renderable->Render(ctx.system.r);
+
+		//	Renderables only filled the geometry batch, draw it all at once
+		FlushDrawing(ctx.system.r);
+		ctx.engine.profiler.EndPhase(FP_Render);
+
+		//	Swap front and back buffer to show results of the render
+		SDL_RenderPresent(ctx.system.r);
+		ctx.engine.profiler.EndPhase(FP_Present);
+	}
 #pragma endregion
 
 #pragma region FPS Regulation
 	/*
-	 * We calculate the frame time, relative to the frame start time.
-	 * If it's below the target frame time, we'll wait for the difference.
-	 * If, instead, the frame take longer than the frame time we have two
-	 * roads to walk:
-	 * - variable frame time: we just don't wait and rush into the next frame
-	 * - fixed frame time: we skip a frame to align to the next fixed frame time
+	 * Wait for the next frame on the pacer's schedule (see
+	 * FramePacer for what happens to late frames). With VSync
+	 * presenting did the waiting already, so the pacer doesn't
+	 * wait at all unless a frame rate was asked for explicitly.
 	 *
-	 * Important note: when working with high resolution clock (or numbers
-	 * in general), data is usually stored in large data formats such as
-	 * long int or even long long int, so it's good practice to avoid
-	 * implicit conversions to make 100% clear what type of data we're
-	 * carying around.
-	 * 
 	 * As stated above, FPS regulation is entrusted to the browser for
 	 * webgl builds, so we'll skip the manual frame rate regulation here
 	 * too.
 	 */
 #ifndef __EMSCRIPTEN__
-	long long elapsedMillis = duration_cast<milliseconds>(high_resolution_clock::now() - frameStart).count();
-#ifdef FRAME_SKIP
-	elapsedMillis %= TARGET_FPS;
-#endif
-	long long waitMillis = (1000 / TARGET_FPS) - elapsedMillis;
-	if(waitMillis > 0)
-		SDL_Delay((int)waitMillis);
+	if(redraw)	//	Still capping the frame rate of a burst of changes, idling is up to the wait for changes
+		ctx.engine.pacer.WaitForNextFrame();
 #endif
+	ctx.engine.profiler.EndPhase(FP_Sleep);
+	//	Frames that weren't drawn are not worth profiling
+	if(redraw)
+		ctx.engine.profiler.EndFrame();
 #pragma endregion
 
 #pragma region WebGL Shutdown
@@ -400,12 +775,90 @@ void SystemShutdown()
 		ctx.game.ticTacToeGame = nullptr;
 	}
 
-	//	Quit all systems
-	SDL_DestroyRenderer(ctx.system.r);
-	SDL_DestroyWindow(ctx.system.window);
+	//	Dispose the debug overlays
+	if(ctx.engine.frameTimeGraph)
+	{
+		delete ctx.engine.frameTimeGraph;
+		ctx.engine.frameTimeGraph = nullptr;
+	}
+
+	//	Quit all systems (no window nor renderer in headless mode)
+	if(ctx.system.r)
+		SDL_DestroyRenderer(ctx.system.r);
+	if(ctx.system.window)
+		SDL_DestroyWindow(ctx.system.window);
 	SDL_Quit();
 }
 
+void HeadlessSetup()
+{
+	/*
+	 * No SDL subsystem to initialize: the game only reads the
+	 * time, and it reads it from a virtual clock that the
+	 * headless loop moves forward by itself.
+	 * The game still wants a viewport to lay its elements out,
+	 * any size will do as nothing is ever drawn.
+	 * With no frames to keep going, the CPU finds its moves
+	 * right away instead of in the background.
+	 */
+	ctx.system.viewport.w = VIEWPORT_W;
+	ctx.system.viewport.h = VIEWPORT_H;
+
+	Clock::Get().UseVirtualClock(true);
+	JobSystem::Get().SetInline(true);
+}
+
+void HeadlessLoop(int gamesCount)
+{
+	/*
+	 * No events, no rendering and no frame rate regulation:
+	 * just update the game over and over. When nothing can
+	 * happen until a given time (whoever waits for it requests
+	 * a wake-up), the virtual clock jumps straight to that time
+	 * instead of waiting for it.
+	 * When a game is over, results are collected and a new
+	 * game starts right away.
+	 */
+	int crossWins = 0;
+	int circleWins = 0;
+	int draws = 0;
+	const steady_clock::time_point loopStart = steady_clock::now();
+
+	for(int gamesPlayed = 0; gamesPlayed < gamesCount; )
+	{
+		Clock::Get().AdvanceToNextWakeUp();
+
+		for(IUpdatable *& updatable : ctx.engine.updateQueue)
+			updatable->Update();
+
+		const Field & field = ctx.game.ticTacToeGame->GetField();
+		if(field.IsGameOn())
+			continue;
+
+		switch(field.GetWinner())
+		{
+			case FG_Cross:
+				crossWins++;
+				break;
+			case FG_Circle:
+				circleWins++;
+				break;
+			default:
+				draws++;
+				break;
+		}
+		gamesPlayed++;
+		ctx.game.ticTacToeGame->StartOver();
+	}
+
+	const double elapsedSeconds = duration_cast<duration<double>>(steady_clock::now() - loopStart).count();
+	cout << "Games played: " << gamesCount << endl;
+	cout << "Cross wins: " << crossWins << endl;
+	cout << "Circle wins: " << circleWins << endl;
+	cout << "Draws: " << draws << endl;
+	cout << "Elapsed time: " << elapsedSeconds << " s (" << (elapsedSeconds > 0.0 ? gamesCount / elapsedSeconds : 0.0) << " games/s)" << endl;
+}
+
 void OverrideControl(int argc, char * argv[], const char * argCheck, ControlType & controlType)
 {
 	/*
@@ -426,5 +879,7 @@ void OverrideControl(int argc, char * argv[], const char * argCheck, ControlType
 				controlType = CT_CPU_Medium;
 			if(strcmp(argv[a + 1], CLI_VAL_CPU_HARD) == 0)
 				controlType = CT_CPU_Hard;
+			else if(strcmp(argv[a + 1], CLI_VAL_CPU_MCTS) == 0)
+				controlType = CT_CPU_MCTS;
 		}
 }
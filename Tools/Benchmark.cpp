@@ -0,0 +1,747 @@
+//	This tool has its own plain entry point, SDL is not initialized at all
+#define SDL_MAIN_HANDLED
+
+#pragma region C++ Includes
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "Clock.h"
+#include "Random.h"
+#include "JobSystem.h"
+#include "SourceState.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "CommandLine.h"
+#include "Field.h"
+#include "TurnsScheduler.h"
+#include "CPUTurnController.h"
+#include "NegamaxSearcher.h"
+#include "MonteCarloTreeSearch.h"
+#include "IterativeDeepeningSearcher.h"
+#include "ThreatSpaceSearcher.h"
+#include "MoveScorer.h"
+#include "BatchEvaluator.h"
+#include "PerfectPlayTable.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Micro benchmarks for the hot paths of the game and of the AI.
+ *
+ * The harness mimics Google Benchmark, both in the way a
+ * benchmark is written (a function looping while the state
+ * says so) and in its command line and JSON output, so the
+ * results can be fed to the same tools used to track results
+ * across commits (e.g. compare.py), without pulling in the
+ * library itself.
+ *
+ * Each benchmark is run with a growing number of iterations,
+ * until a run lasts long enough to be measured reliably, and
+ * the time per iteration of that last run is reported.
+ * Random numbers are seeded before each benchmark, so every
+ * run measures the very same games.
+ */
+
+#pragma region Constant Parameters
+//	Command line arguments
+#define CLI_KEY_FILTER "--benchmark_filter="	//	Followed by a substring of the names of the benchmarks to run
+#define CLI_KEY_MIN_TIME "--benchmark_min_time="	//	Followed by the minimum time to run each benchmark for, in seconds
+#define CLI_KEY_FORMAT "--benchmark_format="	//	Followed by console or json
+#define CLI_KEY_OUT "--benchmark_out="	//	Followed by the path of a file where to write the results as JSON
+#define CLI_VAL_FORMAT_JSON "json"
+#define DEFAULT_MIN_TIME 0.5
+
+#define MAX_ITERATIONS 1000000000ll
+#define BENCHMARK_SEED 0
+
+//	The board is never drawn, any area will do
+#define FIELD_AREA SDL_Rect{0, 0, 600, 600}
+#pragma endregion
+
+#pragma region Harness
+/*
+ * Passed to each benchmark, which must loop while KeepRunning()
+ * returns true and do exactly one iteration of its work each
+ * time. Set up work done before the loop is not measured.
+ */
+class BenchmarkState
+{
+	// Fields
+public:
+protected:
+private:
+	long long iterations;
+	long long remainingIterations;
+	steady_clock::time_point realStart;
+	clock_t cpuStart;
+	double realSeconds = 0.0;
+	double cpuSeconds = 0.0;
+	steady_clock::time_point realPause;
+	clock_t cpuPause;
+	double pausedRealSeconds = 0.0;
+	double pausedCPUSeconds = 0.0;
+	long long itemsProcessed = 0;
+	string label;
+	// Constructors
+public:
+	BenchmarkState(long long iterations) : iterations(iterations), remainingIterations(iterations) { }
+protected:
+private:
+	// Methods
+public:
+	__inline bool KeepRunning()
+	{
+		//	Timing starts with the first iteration, so any set up before the loop is left out
+		if(remainingIterations == iterations)
+		{
+			realStart = steady_clock::now();
+			cpuStart = clock();
+		}
+
+		if(remainingIterations-- > 0)
+			return true;
+
+		realSeconds = duration_cast<duration<double>>(steady_clock::now() - realStart).count() - pausedRealSeconds;
+		cpuSeconds = (double)(clock() - cpuStart) / CLOCKS_PER_SEC - pausedCPUSeconds;
+		return false;
+	}
+
+	//	Work between the two (e.g. resetting a cache) is left out of the time, within the loop
+	__inline void PauseTiming()
+	{
+		realPause = steady_clock::now();
+		cpuPause = clock();
+	}
+
+	__inline void ResumeTiming()
+	{
+		pausedRealSeconds += duration_cast<duration<double>>(steady_clock::now() - realPause).count();
+		pausedCPUSeconds += (double)(clock() - cpuPause) / CLOCKS_PER_SEC;
+	}
+
+	__inline long long GetIterations() const { return iterations; }
+	__inline double GetRealSeconds() const { return realSeconds; }
+	__inline double GetCPUSeconds() const { return cpuSeconds; }
+	//	Items handled by all the iterations together, for benchmarks with a throughput (e.g. positions)
+	__inline void SetItemsProcessed(long long items) { itemsProcessed = items; }
+	__inline long long GetItemsProcessed() const { return itemsProcessed; }
+	//	Reported along with the times, e.g. a ratio to another benchmark
+	__inline void SetLabel(const string & text) { label = text; }
+	__inline const string & GetLabel() const { return label; }
+protected:
+private:
+};
+
+typedef void (*BenchmarkFunction)(BenchmarkState & state);
+
+typedef struct
+{
+	const char * name;
+	BenchmarkFunction function;
+} Benchmark;
+
+typedef struct
+{
+	string name;
+	long long iterations;
+	double realTimeNs;
+	double cpuTimeNs;
+	double itemsPerSecond;	//	Zero for benchmarks with no items
+	string label;	//	Empty for benchmarks with no label
+} BenchmarkResult;
+
+/*
+ * Keep the compiler from optimizing away a value that is
+ * computed only to be measured.
+ */
+template<typename T>
+void DoNotOptimize(const T & value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static const void * volatile sink;
+	sink = &value;
+#endif
+}
+#pragma endregion
+
+#pragma region Benchmarks
+/*
+ * A classic board halfway through a game, with no winner yet
+ * and threats for both factions:
+ *	X O .
+ *	. X .
+ *	. . O
+ */
+void PrepareMidGameField(Field & field)
+{
+	field.MakeMove(0, FG_Cross);
+	field.MakeMove(1, FG_Circle);
+	field.MakeMove(4, FG_Cross);
+	field.MakeMove(8, FG_Circle);
+}
+
+void BM_Field_GetMoveScore(BenchmarkState & state)
+{
+	Field field(FIELD_AREA);
+	PrepareMidGameField(field);
+	const vector<int> emptyCells = field.GetEmptyCells();
+
+	//	One move per iteration, walking through all the empty cells
+	size_t e = 0;
+	while(state.KeepRunning())
+	{
+		const int cell = emptyCells[e];
+		DoNotOptimize(field.GetMoveScore(FG_Cross, field.GetBoard().GetRow(cell), field.GetBoard().GetColumn(cell)));
+		e = e + 1 < emptyCells.size() ? e + 1 : 0;
+	}
+}
+
+void BM_Field_FindBestMove(BenchmarkState & state)
+{
+	Field field(FIELD_AREA);
+	PrepareMidGameField(field);
+
+	while(state.KeepRunning())
+		DoNotOptimize(field.FindBestMove(FG_Cross));
+}
+
+/*
+ * A 19x19 board (five in a row) with 60 glyphs scattered on it,
+ * the same ones on every run, as random numbers are seeded.
+ */
+void PrepareLargeBoard(Board & board)
+{
+	for(int glyphs = 0; glyphs < 60; glyphs++)
+	{
+		const vector<int> & emptyCells = board.GetEmptyCells();
+		board.MakeMove(emptyCells[Random::Range(0, (int)emptyCells.size())], glyphs % 2 == 0 ? FG_Cross : FG_Circle);
+	}
+}
+
+void BM_Field_FindBestMove_19x19(BenchmarkState & state)
+{
+	BoardRules rules;
+	rules.columns = 19;
+	rules.rows = 19;
+	rules.runLength = 5;
+	Field field(FIELD_AREA, rules);
+	Board board(rules);
+	PrepareLargeBoard(board);
+	for(int cell = 0; cell < board.GetCellsCount(); cell++)
+		if(board.Get(cell) != FG_None)
+			field.MakeMove(cell, board.Get(cell));
+
+	while(state.KeepRunning())
+		DoNotOptimize(field.FindBestMove(FG_Cross));
+}
+
+void BM_MoveScorer_Score(BenchmarkState & state)
+{
+	//	Every cell of the 19x19 board at once, with the widest instructions of the build
+	BoardRules rules;
+	rules.columns = 19;
+	rules.rows = 19;
+	rules.runLength = 5;
+	Board board(rules);
+	PrepareLargeBoard(board);
+	MoveScorer scorer;
+
+	while(state.KeepRunning())
+		DoNotOptimize(scorer.Score(board, FG_Cross)[0]);
+}
+
+/*
+ * Evaluation of 65536 positions from random games, stopped at
+ * any point, on the given board, with the given threads: its
+ * throughput is reported in positions per second.
+ */
+void RunBatchEvaluation(BenchmarkState & state, int columns, int rows, int runLength, int threadsCount)
+{
+	BoardRules rules;
+	rules.columns = columns;
+	rules.rows = rows;
+	rules.runLength = runLength;
+	Board board(rules);
+	PositionBatch batch;
+	for(int position = 0; position < 65536; position++)
+	{
+		board.Reset();
+		const int movesCount = Random::Range(0, board.GetCellsCount());
+		for(int move = 0; move < movesCount && !board.IsGameOver(); move++)
+		{
+			const vector<int> & emptyCells = board.GetEmptyCells();
+			board.MakeMove(emptyCells[Random::Range(0, (int)emptyCells.size())], move % 2 == 0 ? FG_Cross : FG_Circle);
+		}
+		batch.Add(board);
+	}
+
+	BatchEvaluator evaluator(rules, threadsCount);
+	BatchResults results;
+
+	while(state.KeepRunning())
+	{
+		evaluator.Evaluate(batch, results);
+		DoNotOptimize(results.bestMoves[0]);
+	}
+	state.SetItemsProcessed(state.GetIterations() * (long long)batch.GetCount());
+}
+
+void BM_BatchEvaluator_Evaluate_3x3(BenchmarkState & state) { RunBatchEvaluation(state, 3, 3, 3, 1); }
+void BM_BatchEvaluator_Evaluate_8x8(BenchmarkState & state) { RunBatchEvaluation(state, 8, 8, 5, 1); }
+void BM_BatchEvaluator_Evaluate_8x8_AllThreads(BenchmarkState & state) { RunBatchEvaluation(state, 8, 8, 5, 0); }
+
+void BM_Field_GetWinner(BenchmarkState & state)
+{
+	Field field(FIELD_AREA);
+	PrepareMidGameField(field);
+
+	while(state.KeepRunning())
+	{
+		DoNotOptimize(field);
+		DoNotOptimize(field.GetWinner());
+	}
+}
+
+void BM_Field_MakeMoveReset(BenchmarkState & state)
+{
+	//	A whole game, ending in a draw, then back to an empty board
+	const int moves[] = { 4, 0, 2, 6, 3, 5, 1, 7, 8 };
+	Field field(FIELD_AREA);
+
+	while(state.KeepRunning())
+	{
+		FactionGlyph glyph = FG_Cross;
+		for(const int move : moves)
+		{
+			field.MakeMove(move, glyph);
+			glyph = GetOpponentGlyph(glyph);
+		}
+		DoNotOptimize(field.GetWinner());
+		field.Reset();
+	}
+}
+
+void RunCPUvsCPU(BenchmarkState & state, Difficulty difficulty)
+{
+	//	A whole game per iteration, on a virtual clock, moves found inline
+	Clock::Get().UseVirtualClock(true);
+	JobSystem::Get().SetInline(true);
+
+	Field field(FIELD_AREA);
+	CPUTurnController crossController(difficulty, field, FG_Cross);
+	CPUTurnController circleController(difficulty, field, FG_Circle);
+	TurnsScheduler turnsScheduler;
+	turnsScheduler.AddTurn(&crossController);
+	turnsScheduler.AddTurn(&circleController);
+
+	while(state.KeepRunning())
+	{
+		while(field.IsGameOn())
+		{
+			Clock::Get().AdvanceToNextWakeUp();
+			turnsScheduler.Update();
+		}
+		DoNotOptimize(field.GetWinner());
+
+		turnsScheduler.StartOver();
+		field.Reset();
+	}
+
+	JobSystem::Get().SetInline(false);
+	Clock::Get().UseVirtualClock(false);
+}
+
+void BM_Game_CPUvsCPU_Easy(BenchmarkState & state) { RunCPUvsCPU(state, Difficulty::Easy); }
+void BM_Game_CPUvsCPU_Medium(BenchmarkState & state) { RunCPUvsCPU(state, Difficulty::Medium); }
+void BM_Game_CPUvsCPU_Hard(BenchmarkState & state) { RunCPUvsCPU(state, Difficulty::Hard); }
+
+void BM_NegamaxSearcher_Search(BenchmarkState & state)
+{
+	//	Solve the whole game from the empty board
+	NegamaxSearcher searcher;
+	searcher.SetUseTranspositionTable(false);
+
+	while(state.KeepRunning())
+		DoNotOptimize(searcher.Search(Bitboard(), FG_Cross));
+}
+
+void BM_MonteCarloTreeSearch_Search(BenchmarkState & state)
+{
+	/*
+	 * A thousand playouts on one thread from the empty 7x7 board
+	 * (four in a row): divide the playouts by the time to get
+	 * the playouts per second of a single core.
+	 */
+	BoardRules rules;
+	rules.columns = 7;
+	rules.rows = 7;
+	rules.runLength = 4;
+	const Board board(rules);
+
+	MCTSSettings settings;
+	settings.threadsCount = 1;
+	settings.maxPlayouts = 1000;
+	settings.timeBudgetMillis = 60000;
+	MonteCarloTreeSearch search(settings);
+
+	while(state.KeepRunning())
+		DoNotOptimize(search.Search(board, FG_Cross).bestMove);
+}
+
+void BM_IterativeDeepeningSearcher_Search(BenchmarkState & state)
+{
+	/*
+	 * Four plies deep from an opening on the 15x15 board (five in
+	 * a row), with no deadline: divide the nodes by the time to
+	 * get the nodes per second of a single core.
+	 */
+	BoardRules rules;
+	rules.columns = 15;
+	rules.rows = 15;
+	rules.runLength = 5;
+	Board board(rules);
+	board.MakeMove(board.ToCell(7, 7), FG_Cross);
+	board.MakeMove(board.ToCell(7, 8), FG_Circle);
+	board.MakeMove(board.ToCell(8, 8), FG_Cross);
+	board.MakeMove(board.ToCell(6, 6), FG_Circle);
+
+	DeepeningSettings settings;
+	settings.timeBudgetMillis = 60000;
+	settings.maxDepth = 4;
+	settings.tableMegabytes = 0;
+	IterativeDeepeningSearcher searcher(settings);
+
+	while(state.KeepRunning())
+		DoNotOptimize(searcher.Search(board, FG_Cross).bestMove);
+}
+
+//	Time to depth of a single thread, for the speedup of more threads, once its benchmark has run
+double lazySMPBaselineNs = 0.0;
+
+void RunLazySMPSearch(BenchmarkState & state, int threadsCount)
+{
+	/*
+	 * Five plies deep from an opening on the 15x15 board (five in
+	 * a row), with the transposition table, cleared before each
+	 * search: the time to reach the depth, for one thread and
+	 * for more, with the speedup over one thread as the label.
+	 * Only threads of their own cores speed it up, the speedup
+	 * is meaningless beyond the hardware threads.
+	 */
+	BoardRules rules;
+	rules.columns = 15;
+	rules.rows = 15;
+	rules.runLength = 5;
+	Board board(rules);
+	board.MakeMove(board.ToCell(7, 7), FG_Cross);
+	board.MakeMove(board.ToCell(7, 8), FG_Circle);
+	board.MakeMove(board.ToCell(8, 8), FG_Cross);
+	board.MakeMove(board.ToCell(6, 6), FG_Circle);
+
+	DeepeningSettings settings;
+	settings.timeBudgetMillis = 600000;
+	settings.maxDepth = 5;
+	settings.threadsCount = threadsCount;
+	IterativeDeepeningSearcher searcher(settings);
+
+	while(state.KeepRunning())
+	{
+		state.PauseTiming();
+		searcher.ClearTable();
+		state.ResumeTiming();
+		DoNotOptimize(searcher.Search(board, FG_Cross).bestMove);
+	}
+
+	const double timeNs = state.GetRealSeconds() * 1e9 / state.GetIterations();
+	if(threadsCount == 1)
+		lazySMPBaselineNs = timeNs;
+	ostringstream label;
+	label << "threads=" << (threadsCount > 0 ? threadsCount : ThreadPool::GetHardwareThreadsCount());
+	if(lazySMPBaselineNs > 0.0)
+		label << " speedup=" << fixed << setprecision(2) << lazySMPBaselineNs / timeNs << "x";
+	state.SetLabel(label.str());
+}
+
+void BM_IterativeDeepeningSearcher_LazySMP_1Thread(BenchmarkState & state)
+{
+	RunLazySMPSearch(state, 1);
+}
+
+void BM_IterativeDeepeningSearcher_LazySMP_2Threads(BenchmarkState & state)
+{
+	RunLazySMPSearch(state, 2);
+}
+
+void BM_IterativeDeepeningSearcher_LazySMP_4Threads(BenchmarkState & state)
+{
+	RunLazySMPSearch(state, 4);
+}
+
+void BM_IterativeDeepeningSearcher_LazySMP_AllThreads(BenchmarkState & state)
+{
+	RunLazySMPSearch(state, 0);
+}
+
+void BM_ThreatSpaceSearcher_Search(BenchmarkState & state)
+{
+	/*
+	 * A forced win through fours, twelve moves of the cross long,
+	 * on the 15x15 board (five in a row): from the search for the
+	 * shortest win to the first move of it.
+	 */
+	BoardRules rules;
+	rules.columns = 15;
+	rules.rows = 15;
+	rules.runLength = 5;
+	Board board(rules);
+	const int crosses[][2] = { {2, 8}, {3, 3}, {4, 6}, {6, 3}, {6, 4}, {8, 7}, {9, 7}, {9, 11}, {11, 4}, {11, 9}, {12, 4}, {12, 6} };
+	const int circles[][2] = { {2, 12}, {3, 2}, {4, 7}, {4, 8}, {7, 4}, {7, 6}, {8, 11}, {9, 6} };
+	for(const auto & cross : crosses)
+		board.MakeMove(board.ToCell(cross[0], cross[1]), FG_Cross);
+	for(const auto & circle : circles)
+		board.MakeMove(board.ToCell(circle[0], circle[1]), FG_Circle);
+
+	ThreatSettings settings;
+	settings.timeBudgetMillis = 60000;
+	settings.maxDepth = 16;
+	ThreatSpaceSearcher searcher(settings);
+
+	while(state.KeepRunning())
+		DoNotOptimize(searcher.Search(board, FG_Cross).winningMove);
+}
+
+void BM_PerfectPlayTable_Lookup(BenchmarkState & state)
+{
+	Field field(FIELD_AREA);
+	PrepareMidGameField(field);
+	const Bitboard board = field.GetBoard().ToBitboard();
+
+	while(state.KeepRunning())
+	{
+		DoNotOptimize(board);
+		DoNotOptimize(PerfectPlayTable::Lookup(board).bestMoves);
+	}
+}
+
+void BM_State_Step(BenchmarkState & state)
+{
+	/*
+	 * The input path of a frame: a few buttons change, the
+	 * state steps to the next frame and a few buttons are
+	 * queried, with as many sources as a keyboard has keys.
+	 */
+	const int sourcesCount = 128;
+	ButtonsState<SparseSlots> buttonsState(sourcesCount);
+	for(int id = 0; id < sourcesCount; id++)
+		buttonsState.Set(id, false);
+
+	int frame = 0;
+	while(state.KeepRunning())
+	{
+		buttonsState.Step();
+		buttonsState.Set(frame % sourcesCount, (frame & 1) != 0);
+		DoNotOptimize(buttonsState.GetPressed(frame % sourcesCount));
+		DoNotOptimize(buttonsState.GetReleased(1));
+		frame++;
+	}
+}
+
+const Benchmark Benchmarks[] =
+{
+	{ "BM_Field_GetMoveScore", BM_Field_GetMoveScore },
+	{ "BM_Field_FindBestMove", BM_Field_FindBestMove },
+	{ "BM_Field_FindBestMove/19x19", BM_Field_FindBestMove_19x19 },
+	{ "BM_MoveScorer_Score", BM_MoveScorer_Score },
+	{ "BM_BatchEvaluator_Evaluate/3x3", BM_BatchEvaluator_Evaluate_3x3 },
+	{ "BM_BatchEvaluator_Evaluate/8x8", BM_BatchEvaluator_Evaluate_8x8 },
+	{ "BM_BatchEvaluator_Evaluate/8x8/threads:all", BM_BatchEvaluator_Evaluate_8x8_AllThreads },
+	{ "BM_Field_GetWinner", BM_Field_GetWinner },
+	{ "BM_Field_MakeMoveReset", BM_Field_MakeMoveReset },
+	{ "BM_Game_CPUvsCPU/easy", BM_Game_CPUvsCPU_Easy },
+	{ "BM_Game_CPUvsCPU/medium", BM_Game_CPUvsCPU_Medium },
+	{ "BM_Game_CPUvsCPU/hard", BM_Game_CPUvsCPU_Hard },
+	{ "BM_NegamaxSearcher_Search", BM_NegamaxSearcher_Search },
+	{ "BM_MonteCarloTreeSearch_Search", BM_MonteCarloTreeSearch_Search },
+	{ "BM_IterativeDeepeningSearcher_Search", BM_IterativeDeepeningSearcher_Search },
+	{ "BM_IterativeDeepeningSearcher_LazySMP/threads:1", BM_IterativeDeepeningSearcher_LazySMP_1Thread },
+	{ "BM_IterativeDeepeningSearcher_LazySMP/threads:2", BM_IterativeDeepeningSearcher_LazySMP_2Threads },
+	{ "BM_IterativeDeepeningSearcher_LazySMP/threads:4", BM_IterativeDeepeningSearcher_LazySMP_4Threads },
+	{ "BM_IterativeDeepeningSearcher_LazySMP/threads:all", BM_IterativeDeepeningSearcher_LazySMP_AllThreads },
+	{ "BM_ThreatSpaceSearcher_Search", BM_ThreatSpaceSearcher_Search },
+	{ "BM_PerfectPlayTable_Lookup", BM_PerfectPlayTable_Lookup },
+	{ "BM_State_Step", BM_State_Step }
+};
+#pragma endregion
+
+//	Forward declarations
+BenchmarkResult RunBenchmark(const Benchmark & benchmark, double minSeconds);
+void WriteConsoleReport(ostream & out, const vector<BenchmarkResult> & results);
+void WriteJSONReport(ostream & out, const char * executable, const vector<BenchmarkResult> & results);
+string EscapeJSON(const char * text);
+string FormatCount(double count);
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	const char * filter = CommandLine::FindPrefixedArgValue(argc, argv, CLI_KEY_FILTER);
+	const char * minTimeValue = CommandLine::FindPrefixedArgValue(argc, argv, CLI_KEY_MIN_TIME);
+	const char * format = CommandLine::FindPrefixedArgValue(argc, argv, CLI_KEY_FORMAT);
+	const char * outPath = CommandLine::FindPrefixedArgValue(argc, argv, CLI_KEY_OUT);
+	const double minSeconds = minTimeValue && atof(minTimeValue) > 0.0 ? atof(minTimeValue) : DEFAULT_MIN_TIME;
+	const bool jsonFormat = format && strcmp(format, CLI_VAL_FORMAT_JSON) == 0;
+
+	//	Run all the benchmarks matching the filter, in a fixed order
+	vector<BenchmarkResult> results;
+	for(const Benchmark & benchmark : Benchmarks)
+		if(!filter || strstr(benchmark.name, filter))
+		{
+			results.push_back(RunBenchmark(benchmark, minSeconds));
+			if(!jsonFormat)
+				WriteConsoleReport(cout, vector<BenchmarkResult>(1, results.back()));
+		}
+
+	if(jsonFormat)
+		WriteJSONReport(cout, argv[0], results);
+
+	if(outPath)
+	{
+		ofstream outFile(outPath);
+		WriteJSONReport(outFile, argv[0], results);
+		if(!outFile)
+		{
+			cout << "Couldn't write results to " << outPath << endl;
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+BenchmarkResult RunBenchmark(const Benchmark & benchmark, double minSeconds)
+{
+	/*
+	 * Grow the iterations until a run lasts long enough: the
+	 * next guess is based on the time taken so far, with some
+	 * margin, but never more than ten times the previous one,
+	 * so a noisy short run can't blow the time up.
+	 */
+	long long iterations = 1;
+	for(;;)
+	{
+		Random::Seed(BENCHMARK_SEED);
+		BenchmarkState state(iterations);
+		benchmark.function(state);
+
+		const double realSeconds = state.GetRealSeconds();
+		if(realSeconds >= minSeconds || iterations >= MAX_ITERATIONS)
+			return BenchmarkResult
+			{
+				benchmark.name,
+				iterations,
+				realSeconds * 1e9 / iterations,
+				state.GetCPUSeconds() * 1e9 / iterations,
+				realSeconds > 0.0 ? state.GetItemsProcessed() / realSeconds : 0.0,
+				state.GetLabel()
+			};
+
+		const double multiplier = realSeconds > 0.0 ? min(10.0, max(2.0, minSeconds * 1.4 / realSeconds)) : 10.0;
+		iterations = min(MAX_ITERATIONS, (long long)(iterations * multiplier));
+	}
+}
+
+void WriteConsoleReport(ostream & out, const vector<BenchmarkResult> & results)
+{
+	for(const BenchmarkResult & result : results)
+		out << left << setw(32) << result.name << right
+			<< setw(14) << fixed << setprecision(1) << result.realTimeNs << " ns"
+			<< setw(14) << result.cpuTimeNs << " ns"
+			<< setw(14) << result.iterations
+			<< (result.itemsPerSecond > 0.0 ? " items_per_second=" + FormatCount(result.itemsPerSecond) + "/s" : string())
+			<< (!result.label.empty() ? " " + result.label : string()) << endl;
+}
+
+void WriteJSONReport(ostream & out, const char * executable, const vector<BenchmarkResult> & results)
+{
+	//	Same layout as Google Benchmark's JSON output, limited to the fields that make sense here
+	char date[32];
+	const time_t now = time(nullptr);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+	out << "{\n";
+	out << "  \"context\": {\n";
+	out << "    \"date\": \"" << date << "\",\n";
+	out << "    \"executable\": \"" << EscapeJSON(executable) << "\",\n";
+	out << "    \"num_cpus\": " << thread::hardware_concurrency() << ",\n";
+	out << "    \"move_scorer_instructions\": \"" << MoveScorer::GetInstructionSet() << "\",\n";
+#ifdef NDEBUG
+	out << "    \"library_build_type\": \"release\"\n";
+#else
+	out << "    \"library_build_type\": \"debug\"\n";
+#endif
+	out << "  },\n";
+	out << "  \"benchmarks\": [\n";
+	for(size_t r = 0; r < results.size(); r++)
+	{
+		const BenchmarkResult & result = results[r];
+		out << "    {\n";
+		out << "      \"name\": \"" << result.name << "\",\n";
+		out << "      \"run_name\": \"" << result.name << "\",\n";
+		out << "      \"run_type\": \"iteration\",\n";
+		out << "      \"iterations\": " << result.iterations << ",\n";
+		out << "      \"real_time\": " << fixed << setprecision(3) << result.realTimeNs << ",\n";
+		out << "      \"cpu_time\": " << result.cpuTimeNs << ",\n";
+		if(result.itemsPerSecond > 0.0)
+			out << "      \"items_per_second\": " << result.itemsPerSecond << ",\n";
+		if(!result.label.empty())
+			out << "      \"label\": \"" << result.label << "\",\n";
+		out << "      \"time_unit\": \"ns\"\n";
+		out << "    }" << (r + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "  ]\n";
+	out << "}\n";
+}
+
+string FormatCount(double count)
+{
+	//	Short form with a metric suffix, the way Google Benchmark shows rates
+	const char * suffixes[] = { "", "k", "M", "G", "T" };
+	int suffix = 0;
+	for(; count >= 1000.0 && suffix < 4; suffix++)
+		count /= 1000.0;
+
+	ostringstream formatted;
+	formatted << fixed << setprecision(count < 10.0 ? 3 : count < 100.0 ? 2 : 1) << count << suffixes[suffix];
+	return formatted.str();
+}
+
+string EscapeJSON(const char * text)
+{
+	//	Paths are the only strings coming from outside, backslashes (Windows) and quotes are all they may need
+	string escaped;
+	for(const char * c = text; *c; c++)
+	{
+		if(*c == '\\' || *c == '"')
+			escaped += '\\';
+		escaped += *c;
+	}
+
+	return escaped;
+}
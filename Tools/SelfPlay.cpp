@@ -0,0 +1,183 @@
+//	This tool has its own plain entry point, SDL is not initialized at all
+#define SDL_MAIN_HANDLED
+
+#pragma region C++ Includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "Clock.h"
+#include "Random.h"
+#include "JobSystem.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "CommandLine.h"
+#include "Field.h"
+#include "TurnsScheduler.h"
+#include "CPUTurnController.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Batch self-play: CPU vs CPU games, every difficulty against
+ * every difficulty, spread over as many threads as the machine
+ * has cores, to measure how the difficulties compare and how
+ * fast games can be played.
+ *
+ * Each worker owns everything it plays with (field, turns
+ * scheduler and controllers) and the engine singletons it
+ * relies on, the clock and the random engine, are per thread,
+ * so workers share nothing but an atomic counter to grab the
+ * next batch of games. Results are kept locally by each worker
+ * and only summed up when all workers are done.
+ *
+ * Each batch of games draws its random numbers from its own
+ * stream, whatever the thread playing it: given the same seed,
+ * results are the same with any number of threads.
+ */
+
+#pragma region Constant Parameters
+//	Command line arguments
+#define CLI_KEY_THREADS "--threads"	//	Followed by the number of worker threads, defaults to the number of cores
+#define CLI_KEY_GAMES "--games"	//	Followed by the number of games for each difficulty pairing
+#define CLI_KEY_SEED "--seed"	//	Followed by the seed for random numbers, random if not passed
+#define DEFAULT_GAMES 10000
+
+//	Games grabbed by a worker at once, large enough to keep the shared counter quiet
+#define GAMES_BATCH 256
+
+//	The board is never drawn, any area will do
+#define FIELD_AREA SDL_Rect{0, 0, 600, 600}
+#pragma endregion
+
+#pragma region Exchange data
+const Difficulty Difficulties[] = { Difficulty::Easy, Difficulty::Medium, Difficulty::Hard };
+const char * const DifficultyNames[] = { "easy", "medium", "hard" };
+const int DifficultiesCount = sizeof(Difficulties) / sizeof(Difficulties[0]);
+const int PairingsCount = DifficultiesCount * DifficultiesCount;
+
+typedef struct
+{
+	long long crossWins;
+	long long circleWins;
+	long long draws;
+} PairingStats;
+#pragma endregion
+
+//	Forward declarations
+void Worker(uint64_t seed, int gamesPerPairing, atomic<long long> & nextGame, vector<PairingStats> & stats);
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	const int threadsCount = CommandLine::ParseCount(argc, argv, CLI_KEY_THREADS, max(1, (int)thread::hardware_concurrency()));
+	const int gamesPerPairing = CommandLine::ParseCount(argc, argv, CLI_KEY_GAMES, DEFAULT_GAMES);
+	const uint64_t seed = CommandLine::ParseSeed(argc, argv, CLI_KEY_SEED, Random::GetSeed());
+	cout << "Seed: " << seed << endl;
+
+	//	Spin the workers, each with its own stats
+	atomic<long long> nextGame{0};
+	vector<vector<PairingStats>> workersStats(threadsCount);
+	vector<thread> workers;
+	const steady_clock::time_point start = steady_clock::now();
+	for(int t = 0; t < threadsCount; t++)
+		workers.emplace_back(Worker, seed, gamesPerPairing, ref(nextGame), ref(workersStats[t]));
+	for(thread & worker : workers)
+		worker.join();
+	const double elapsedSeconds = duration_cast<duration<double>>(steady_clock::now() - start).count();
+
+	//	Aggregate and report
+	cout << "Cross vs Circle" << setw(14) << "Cross wins" << setw(14) << "Circle wins" << setw(14) << "Draws" << endl;
+	for(int p = 0; p < PairingsCount; p++)
+	{
+		PairingStats total{0, 0, 0};
+		for(const vector<PairingStats> & workerStats : workersStats)
+		{
+			total.crossWins += workerStats[p].crossWins;
+			total.circleWins += workerStats[p].circleWins;
+			total.draws += workerStats[p].draws;
+		}
+
+		const string pairing = string(DifficultyNames[p / DifficultiesCount]) + " vs " + DifficultyNames[p % DifficultiesCount];
+		cout << left << setw(15) << pairing << right << setw(14) << total.crossWins << setw(14) << total.circleWins << setw(14) << total.draws << endl;
+	}
+
+	const long long gamesCount = (long long)gamesPerPairing * PairingsCount;
+	cout << "Games played: " << gamesCount << " on " << threadsCount << " threads" << endl;
+	cout << "Elapsed time: " << elapsedSeconds << " s (" << (elapsedSeconds > 0.0 ? gamesCount / elapsedSeconds : 0.0) << " games/s)" << endl;
+
+	return 0;
+}
+
+void Worker(uint64_t seed, int gamesPerPairing, atomic<long long> & nextGame, vector<PairingStats> & stats)
+{
+	/*
+	 * Games are numbered pairing after pairing: a batch never
+	 * spans two pairings, so the whole batch is played with the
+	 * same field and controllers. Waits are skipped by jumping
+	 * the thread's virtual clock, and moves are found on the
+	 * thread itself, which has nothing else to do.
+	 */
+	Clock::Get().UseVirtualClock(true);
+	JobSystem::Get().SetInline(true);
+
+	vector<PairingStats> localStats(PairingsCount, PairingStats{0, 0, 0});
+	const long long batchesPerPairing = (gamesPerPairing + GAMES_BATCH - 1) / GAMES_BATCH;
+	const long long batchesCount = batchesPerPairing * PairingsCount;
+	for(long long batch = nextGame++; batch < batchesCount; batch = nextGame++)
+	{
+		const int pairing = (int)(batch / batchesPerPairing);
+		const long long firstGame = (batch % batchesPerPairing) * GAMES_BATCH;
+		const long long batchGames = min((long long)GAMES_BATCH, gamesPerPairing - firstGame);
+		Random::SeedThread(seed, (uint64_t)batch);
+
+		Field field(FIELD_AREA);
+		CPUTurnController crossController(Difficulties[pairing / DifficultiesCount], field, FG_Cross);
+		CPUTurnController circleController(Difficulties[pairing % DifficultiesCount], field, FG_Circle);
+		TurnsScheduler turnsScheduler;
+		turnsScheduler.AddTurn(&crossController);
+		turnsScheduler.AddTurn(&circleController);
+
+		PairingStats & pairingStats = localStats[pairing];
+		for(long long game = 0; game < batchGames; game++)
+		{
+			while(field.IsGameOn())
+			{
+				Clock::Get().AdvanceToNextWakeUp();
+				turnsScheduler.Update();
+			}
+
+			switch(field.GetWinner())
+			{
+				case FG_Cross:
+					pairingStats.crossWins++;
+					break;
+				case FG_Circle:
+					pairingStats.circleWins++;
+					break;
+				default:
+					pairingStats.draws++;
+					break;
+			}
+
+			turnsScheduler.StartOver();
+			field.Reset();
+		}
+	}
+
+	//	Publish results only once, workers never write to memory shared with each other while playing
+	stats = localStats;
+}
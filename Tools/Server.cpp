@@ -0,0 +1,763 @@
+//	This tool has its own plain entry point, SDL is not initialized at all
+#define SDL_MAIN_HANDLED
+
+#pragma region C++ Includes
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "Random.h"
+#include "JobSystem.h"
+#include "Socket.h"
+#include "WorkStealingScheduler.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "CommandLine.h"
+#include "Board.h"
+#include "Field.h"
+#include "TurnsScheduler.h"
+#include "CPUTurnController.h"
+#include "RemoteTurnController.h"
+#include "Tablebase.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Match server: hosts as many independent matches as there are
+ * players asking for them, each one a remote player against
+ * the CPU, all in one process.
+ *
+ * Every match is a field, a turns scheduler and two controllers,
+ * just like the game's, with a RemoteTurnController standing for
+ * the player. Matches only move when something happens to them
+ * (a move arrives, the player asks for a new game): the match is
+ * then submitted to a work-stealing scheduler, whose workers
+ * update it until it waits for the player again, CPU turns
+ * included, right there on the worker. Nothing is done for the
+ * matches in between, so idle matches cost memory only.
+ *
+ * Players connect on the loopback interface, and each connection
+ * carries any number of matches. Each connection has a thread
+ * reading its messages, which only hands moves over to the
+ * matches and never writes, while the workers write the answers:
+ * so a player busy sending never blocks the server answering it.
+ * Matches are kept in a pool, reused when their players leave.
+ *
+ * Given the --test-clients option, the tool also plays against
+ * itself: loopback clients connect, open their matches all at
+ * once and play random moves for the given time, then round trip
+ * times and throughput are reported.
+ */
+
+#pragma region Constant Parameters
+//	Command line arguments
+#define CLI_KEY_PORT "--port"	//	Followed by the port to listen on, any free port if not passed
+#define CLI_KEY_THREADS "--threads"	//	Followed by the number of worker threads, defaults to the number of cores
+#define CLI_KEY_CPU "--cpu"	//	Followed by the difficulty of the CPU: easy, medium or hard (the default)
+#define CLI_KEY_BOARD "-board"	//	Followed by <columns>x<rows> or <columns>x<rows>x<run length>
+#define CLI_KEY_MAX_MATCHES "--max-matches"	//	Followed by the most matches hosted at once
+#define CLI_KEY_TABLEBASE "--tablebase"	//	Followed by the path of a tablebase, the hard CPU plays perfectly on its board
+#define CLI_KEY_CPU_TIME "--cpu-time"	//	Followed by the most milliseconds the hard CPU searches for each move, on boards other than the classic one
+#define CLI_KEY_CPU_DEPTH "--cpu-depth"	//	Followed by the most plies the hard CPU searches for each move, on boards other than the classic one, 0 for no limit
+#define CLI_KEY_TEST_CLIENTS "--test-clients"	//	Followed by the number of loopback clients to play against the server
+#define CLI_KEY_TEST_MATCHES "--test-matches"	//	Followed by the number of matches the loopback clients play at once, in total
+#define CLI_KEY_TEST_SECONDS "--test-seconds"	//	Followed by how long the loopback clients keep starting new games
+#define CLI_KEY_SEED "--seed"	//	Followed by the seed for the moves of the loopback clients, random if not passed
+#define DEFAULT_MAX_MATCHES 262144
+#define DEFAULT_TEST_MATCHES 100000
+#define DEFAULT_TEST_SECONDS 10
+//	A search holds its worker, and every match waiting on that worker, until it's done
+#define DEFAULT_CPU_TIME 100
+
+//	Bytes read from a connection at once, any multiple of the message size
+#define RECEIVE_BUFFER_SIZE 65536
+
+//	The board is never drawn, any area will do
+const SDL_Rect FieldArea = { 0, 0, 600, 600 };
+#pragma endregion
+
+#pragma region Exchange data
+/*
+ * Every message is 8 bytes, in the byte order of the machine:
+ * both ends run on the same one. Match ids are chosen by the
+ * players, each one within its own connection.
+ */
+enum MessageType : uint8_t
+{
+	MT_NewMatch,	//	Player to server, plays the glyph given as the remote player, or a new game of the match if it exists (same sides)
+	MT_Move,	//	Player to server, the cell to play
+	MT_YourTurn,	//	Server to player, with the opponent's last move (-1 on a new game)
+	MT_MoveRejected,	//	Server to player, the cell can't be played, another move is expected
+	MT_GameOver	//	Server to player, with the glyph of the winner (none on a draw)
+};
+
+struct Message
+{
+	uint32_t matchId;
+	int16_t value;
+	uint8_t type;
+	uint8_t glyph;
+};
+static_assert(sizeof(Message) == 8, "Messages are exactly 8 bytes on the wire");
+
+const char * const DifficultyNames[] = { "easy", "medium", "hard" };
+const Difficulty Difficulties[] = { Difficulty::Easy, Difficulty::Medium, Difficulty::Hard };
+const int DifficultiesCount = sizeof(Difficulties) / sizeof(Difficulties[0]);
+
+typedef struct
+{
+	long long moves;
+	long long games;
+	long long remoteWins;
+	long long cpuWins;
+	long long draws;
+	long long rejectedMoves;
+	vector<float> roundTripsMicros;
+	bool failed;
+} ClientStats;
+#pragma endregion
+
+/*
+ * A connection with a player, shared by the reader thread and
+ * by the workers answering on it, which take turns to write.
+ */
+class Connection
+{
+	// Fields
+public:
+	Socket socket;
+	thread reader;
+	atomic<bool> finished{false};
+protected:
+private:
+	mutex sendMutex;
+	// Constructors
+public:
+	Connection(Socket && socket) : socket(move(socket)) { }
+protected:
+private:
+	// Methods
+public:
+	bool Send(const Message & message)
+	{
+		lock_guard<mutex> lock(sendMutex);
+		return socket.SendAll(&message, sizeof(message));
+	}
+protected:
+private:
+};
+
+/*
+ * A match of the pool, along with what its step needs to know.
+ * The connection and the match id within it only change while
+ * holding the step lock, so workers find them consistent.
+ */
+class Match : public IRemoteLink
+{
+	// Fields
+public:
+	Field field;
+	RemoteTurnController remoteController;
+	CPUTurnController cpuController;
+	TurnsScheduler turnsScheduler;
+	mutex stepMutex;
+	atomic<bool> queued{false};
+	atomic<bool> newGameRequested{false};
+	Connection * connection = nullptr;
+	uint32_t matchId = 0;
+	bool gameOverReported = false;
+protected:
+private:
+	// Constructors
+public:
+	Match(FactionGlyph remoteGlyph, Difficulty difficulty, const BoardRules & rules) :
+		field(FieldArea, rules),
+		remoteController(field, *this, remoteGlyph),
+		cpuController(difficulty, field, GetOpponentGlyph(remoteGlyph))
+	{
+		//	Cross always goes first
+		turnsScheduler.AddTurn(remoteGlyph == FG_Cross ? (ATurnController *)&remoteController : &cpuController);
+		turnsScheduler.AddTurn(remoteGlyph == FG_Cross ? (ATurnController *)&cpuController : &remoteController);
+	}
+protected:
+private:
+	// Methods
+public:
+	__inline FactionGlyph GetRemoteGlyph() const { return remoteController.GetFactionGlyph(); }
+	__inline void Send(MessageType type, int value, FactionGlyph glyph) { connection->Send(Message{ matchId, (int16_t)value, (uint8_t)type, (uint8_t)glyph }); }
+
+	//	IRemoteLink implementation
+	void RequestMove(int lastMove) override { Send(MT_YourTurn, lastMove, FG_None); }
+	void RejectMove(int cell) override { Send(MT_MoveRejected, cell, FG_None); }
+protected:
+private:
+};
+
+class MatchServer
+{
+	// Fields
+public:
+protected:
+private:
+	Difficulty difficulty;
+	BoardRules rules;
+	vector<unique_ptr<Match>> matches;	//	Sized once, matches are created as needed and never go away
+	int createdMatches = 0;
+	vector<int> freeMatches[2];	//	By remote glyph, the sides of a match never change
+	int hostedMatches = 0;
+	int peakHostedMatches = 0;
+	bool poolFullReported = false;
+	mutex poolMutex;
+	Socket listener;
+	atomic<bool> stopping{false};
+	list<unique_ptr<Connection>> connections;
+	WorkStealingScheduler scheduler;	//	Declared last, so workers are gone before the matches they step
+	// Constructors
+public:
+	MatchServer(Difficulty difficulty, const BoardRules & rules, int maxMatches, int threadsCount) :
+		difficulty(difficulty),
+		rules(rules),
+		matches(maxMatches),
+		scheduler([this](int match) { StepMatch(match); }, threadsCount)
+	{ }
+	~MatchServer();
+protected:
+private:
+	// Methods
+public:
+	bool Listen(uint16_t port) { return listener.Listen(port, 256); }
+	__inline uint16_t GetPort() const { return listener.GetLocalPort(); }
+	__inline int GetWorkersCount() const { return scheduler.GetWorkersCount(); }
+	int GetPeakHostedMatches();
+
+	//	Accepts connections until stopped
+	void Run();
+	void Stop();
+protected:
+private:
+	void ServeConnection(Connection & connection);
+	void HandleMessage(Connection & connection, const Message & message, unordered_map<uint32_t, int> & connectionMatches);
+	void ScheduleMatch(int match);
+	void StepMatch(int match);
+	int AcquireMatch(FactionGlyph remoteGlyph);
+	void ReleaseMatch(int match);
+	void ReapConnections(bool all);
+};
+
+//	Forward declarations
+void RunTestClient(uint16_t port, int firstMatch, int matchesCount, double seconds, const BoardRules & rules, uint64_t seed, ClientStats & stats);
+void ReportTestClients(const vector<ClientStats> & clientsStats, double elapsedSeconds);
+Difficulty ParseDifficulty(int argc, char * argv[], const char * argCheck, Difficulty defaultDifficulty);
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	const int threadsCount = CommandLine::ParseCount(argc, argv, CLI_KEY_THREADS, 0);
+	const int port = CommandLine::ParseCount(argc, argv, CLI_KEY_PORT, 0);
+	const int maxMatches = CommandLine::ParseCount(argc, argv, CLI_KEY_MAX_MATCHES, DEFAULT_MAX_MATCHES);
+	const Difficulty difficulty = ParseDifficulty(argc, argv, CLI_KEY_CPU, Difficulty::Hard);
+	//	Cells travel as 16 bits numbers
+	const BoardRules rules = CommandLine::ParseBoardRules(argc, argv, CLI_KEY_BOARD, BoardRules(), INT16_MAX);
+	const int testClientsCount = CommandLine::ParseCount(argc, argv, CLI_KEY_TEST_CLIENTS, 0);
+
+	if(!Socket::Startup())
+	{
+		cout << "Can't use sockets on this machine" << endl;
+		return 1;
+	}
+
+	//	Mapped once, all the matches (and any other server on the machine) share its pages
+	Tablebase tablebase;
+	const char * tablebasePath = CommandLine::FindArgValue(argc, argv, CLI_KEY_TABLEBASE);
+	if(tablebasePath)
+	{
+		if(!tablebase.Open(tablebasePath))
+			cout << "Couldn't open the tablebase " << tablebasePath << endl;
+		else if(!tablebase.Covers(rules))
+			cout << "Ignoring the tablebase " << tablebasePath << ", it's for another board" << endl;
+		else
+			CPUTurnController::SetTablebase(&tablebase);
+	}
+
+	//	Matches are already spread over the cores, and a table of its own per match would add up to far too much memory
+	DeepeningSettings deepeningSettings = CPUTurnController::GetDefaultSettings();
+	deepeningSettings.timeBudgetMillis = DEFAULT_CPU_TIME;
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_CPU_TIME, deepeningSettings.timeBudgetMillis);
+	CommandLine::OverrideCount(argc, argv, CLI_KEY_CPU_DEPTH, deepeningSettings.maxDepth, 0);
+	deepeningSettings.threadsCount = 1;
+	deepeningSettings.tableMegabytes = 0;
+	CPUTurnController::SetDefaultSettings(deepeningSettings);
+
+	MatchServer server(difficulty, rules, maxMatches, threadsCount);
+	if(!server.Listen((uint16_t)port))
+	{
+		cout << "Can't listen on port " << port << endl;
+		return 1;
+	}
+	cout << "Listening on 127.0.0.1:" << server.GetPort() << " with " << server.GetWorkersCount() << " workers, CPU on " << DifficultyNames[(int)difficulty] << endl;
+
+	//	Serve until killed
+	if(testClientsCount < 1)
+	{
+		server.Run();
+		return 0;
+	}
+
+	//	Play against the loopback clients, matches split evenly among them
+	const int testMatchesCount = CommandLine::ParseCount(argc, argv, CLI_KEY_TEST_MATCHES, DEFAULT_TEST_MATCHES);
+	const int testSeconds = CommandLine::ParseCount(argc, argv, CLI_KEY_TEST_SECONDS, DEFAULT_TEST_SECONDS);
+	const uint64_t seed = CommandLine::ParseSeed(argc, argv, CLI_KEY_SEED, Random::GetSeed());
+	cout << "Seed: " << seed << endl;
+
+	thread serving(&MatchServer::Run, &server);
+	vector<ClientStats> clientsStats(testClientsCount);
+	vector<thread> clients;
+	const steady_clock::time_point start = steady_clock::now();
+	for(int c = 0; c < testClientsCount; c++)
+	{
+		const int firstMatch = (int)((long long)testMatchesCount * c / testClientsCount);
+		const int lastMatch = (int)((long long)testMatchesCount * (c + 1) / testClientsCount);
+		clients.emplace_back(RunTestClient, server.GetPort(), firstMatch, lastMatch - firstMatch, (double)testSeconds, cref(rules), seed, ref(clientsStats[c]));
+	}
+	for(thread & client : clients)
+		client.join();
+	const double elapsedSeconds = duration_cast<duration<double>>(steady_clock::now() - start).count();
+
+	server.Stop();
+	serving.join();
+
+	ReportTestClients(clientsStats, elapsedSeconds);
+	cout << "Matches hosted at once: " << server.GetPeakHostedMatches() << endl;
+
+	for(const ClientStats & stats : clientsStats)
+		if(stats.failed || stats.rejectedMoves > 0)
+			return 1;
+
+	return 0;
+}
+
+MatchServer::~MatchServer()
+{
+	//	Readers are done before the workers go, so nothing is submitted to a scheduler going away
+	ReapConnections(true);
+}
+
+int MatchServer::GetPeakHostedMatches()
+{
+	lock_guard<mutex> lock(poolMutex);
+	return peakHostedMatches;
+}
+
+void MatchServer::Run()
+{
+	while(true)
+	{
+		Socket accepted = listener.Accept();
+		if(stopping)
+			break;
+		if(!accepted.IsOpen())
+			continue;
+
+		//	Answers are a few bytes each, they must leave right away
+		accepted.SetNoDelay(true);
+		ReapConnections(false);
+
+		connections.emplace_back(new Connection(move(accepted)));
+		Connection & connection = *connections.back();
+		connection.reader = thread(&MatchServer::ServeConnection, this, ref(connection));
+	}
+}
+
+void MatchServer::Stop()
+{
+	//	Waiting to accept can't be called off the same way everywhere, a connection wakes it up
+	stopping = true;
+	Socket wakeUp;
+	wakeUp.Connect(GetPort());
+}
+
+void MatchServer::ServeConnection(Connection & connection)
+{
+	//	Only this thread knows the matches of the connection, by their id within it
+	unordered_map<uint32_t, int> connectionMatches;
+
+	vector<char> buffer(RECEIVE_BUFFER_SIZE);
+	size_t bufferedBytes = 0;
+	while(true)
+	{
+		const int receivedBytes = connection.socket.Receive(buffer.data() + bufferedBytes, buffer.size() - bufferedBytes);
+		if(receivedBytes <= 0)
+			break;
+		bufferedBytes += receivedBytes;
+
+		//	Whole messages only, the rest waits for the next bytes
+		const size_t messagesCount = bufferedBytes / sizeof(Message);
+		for(size_t m = 0; m < messagesCount; m++)
+		{
+			Message message;
+			memcpy(&message, buffer.data() + m * sizeof(Message), sizeof(Message));
+			HandleMessage(connection, message, connectionMatches);
+		}
+
+		const size_t handledBytes = messagesCount * sizeof(Message);
+		memmove(buffer.data(), buffer.data() + handledBytes, bufferedBytes - handledBytes);
+		bufferedBytes -= handledBytes;
+	}
+
+	//	The player is gone, its matches go back to the pool as soon as they're not stepped
+	for(const pair<const uint32_t, int> & connectionMatch : connectionMatches)
+	{
+		Match & match = *matches[connectionMatch.second];
+		{
+			lock_guard<mutex> lock(match.stepMutex);
+			match.connection = nullptr;
+		}
+		ReleaseMatch(connectionMatch.second);
+	}
+
+	connection.finished = true;
+}
+
+void MatchServer::HandleMessage(Connection & connection, const Message & message, unordered_map<uint32_t, int> & connectionMatches)
+{
+	const unordered_map<uint32_t, int>::const_iterator found = connectionMatches.find(message.matchId);
+	switch(message.type)
+	{
+		case MT_NewMatch:
+		{
+			int match = found != connectionMatches.end() ? found->second : -1;
+			if(match < 0)
+			{
+				if(message.glyph != FG_Cross && message.glyph != FG_Circle)
+					return;
+
+				match = AcquireMatch((FactionGlyph)message.glyph);
+				if(match < 0)
+					return;
+
+				//	Steps of the match's previous player may still be queued, they'll find the new one
+				Match & acquiredMatch = *matches[match];
+				lock_guard<mutex> lock(acquiredMatch.stepMutex);
+				acquiredMatch.connection = &connection;
+				acquiredMatch.matchId = message.matchId;
+				connectionMatches[message.matchId] = match;
+			}
+
+			matches[match]->newGameRequested = true;
+			ScheduleMatch(match);
+			break;
+		}
+		case MT_Move:
+			if(found == connectionMatches.end())
+				return;
+
+			matches[found->second]->remoteController.DeliverMove(message.value);
+			ScheduleMatch(found->second);
+			break;
+		default:
+			break;
+	}
+}
+
+void MatchServer::ScheduleMatch(int match)
+{
+	//	A match is queued once at most, however many messages it gets in the meantime
+	if(!matches[match]->queued.exchange(true))
+		scheduler.Submit(match);
+}
+
+void MatchServer::StepMatch(int matchIndex)
+{
+	/*
+	 * The match is let go before it's stepped: what arrives from
+	 * now on submits it again, and the step lock makes the new
+	 * step wait for this one, so nothing is ever missed.
+	 * CPU moves are found right here, workers have nothing better
+	 * to do, and the match is updated as long as turns advance:
+	 * it stops when the player is asked for a move, or at the end
+	 * of the game.
+	 */
+	Match & match = *matches[matchIndex];
+	match.queued = false;
+
+	lock_guard<mutex> lock(match.stepMutex);
+	if(!match.connection)
+		return;
+
+	JobSystem::Get().SetInline(true);
+	if(match.newGameRequested.exchange(false))
+	{
+		match.turnsScheduler.StartOver();
+		match.field.Reset();
+		match.turnsScheduler.ConsumeTurnAdvanced();
+		match.gameOverReported = false;
+	}
+
+	while(match.field.IsGameOn())
+	{
+		match.turnsScheduler.Update();
+		if(!match.turnsScheduler.ConsumeTurnAdvanced())
+			break;
+	}
+
+	if(match.field.IsGameOver() && !match.gameOverReported)
+	{
+		match.Send(MT_GameOver, -1, match.field.GetWinner());
+		match.gameOverReported = true;
+	}
+}
+
+int MatchServer::AcquireMatch(FactionGlyph remoteGlyph)
+{
+	lock_guard<mutex> lock(poolMutex);
+
+	//	A match left by another player, or a new one while there's room
+	vector<int> & freeGlyphMatches = freeMatches[remoteGlyph == FG_Cross ? 0 : 1];
+	int match;
+	if(!freeGlyphMatches.empty())
+	{
+		match = freeGlyphMatches.back();
+		freeGlyphMatches.pop_back();
+	}
+	else if(createdMatches < (int)matches.size())
+	{
+		match = createdMatches++;
+		matches[match].reset(new Match(remoteGlyph, difficulty, rules));
+	}
+	else
+	{
+		if(!poolFullReported)
+			cout << "All " << matches.size() << " matches are taken, new ones are refused (see " << CLI_KEY_MAX_MATCHES << ")" << endl;
+		poolFullReported = true;
+		return -1;
+	}
+
+	hostedMatches++;
+	peakHostedMatches = max(peakHostedMatches, hostedMatches);
+	return match;
+}
+
+void MatchServer::ReleaseMatch(int match)
+{
+	lock_guard<mutex> lock(poolMutex);
+	freeMatches[matches[match]->GetRemoteGlyph() == FG_Cross ? 0 : 1].push_back(match);
+	hostedMatches--;
+}
+
+void MatchServer::ReapConnections(bool all)
+{
+	//	Finished readers are joined, the others only when all connections go
+	for(list<unique_ptr<Connection>>::iterator connection = connections.begin(); connection != connections.end();)
+	{
+		if(!all && !(*connection)->finished)
+		{
+			connection++;
+			continue;
+		}
+
+		(*connection)->socket.Shutdown();
+		(*connection)->reader.join();
+		connection = connections.erase(connection);
+	}
+}
+
+void RunTestClient(uint16_t port, int firstMatch, int matchesCount, double seconds, const BoardRules & rules, uint64_t seed, ClientStats & stats)
+{
+	/*
+	 * A player with many matches at once, each with its own copy
+	 * of the board, where the server's moves are played too. All
+	 * the answers to a batch of messages go in a single write.
+	 * Once the time is up no new games are started, and the
+	 * client leaves when all of its games are over.
+	 * The round trip is the time from a message sent for a match
+	 * to the server's answer for it, when it's the player's turn
+	 * again (the CPU move included) or when the game is over.
+	 */
+	stats = ClientStats{0, 0, 0, 0, 0, 0, vector<float>(), false};
+	Random::SeedThread(seed, (uint64_t)firstMatch);
+
+	Socket socket;
+	if(!socket.Connect(port))
+	{
+		cout << "Test client can't connect to port " << port << endl;
+		stats.failed = true;
+		return;
+	}
+	socket.SetNoDelay(true);
+
+	//	Matches alternate sides
+	vector<Board> boards(matchesCount, Board(rules));
+	vector<FactionGlyph> glyphs(matchesCount);
+	vector<steady_clock::time_point> sentTimes(matchesCount, steady_clock::now());
+	vector<Message> outgoing;
+	for(int m = 0; m < matchesCount; m++)
+	{
+		glyphs[m] = (firstMatch + m) % 2 == 0 ? FG_Cross : FG_Circle;
+		outgoing.push_back(Message{ (uint32_t)m, 0, MT_NewMatch, (uint8_t)glyphs[m] });
+	}
+
+	const steady_clock::time_point deadline = steady_clock::now() + duration_cast<steady_clock::duration>(duration<double>(seconds));
+	vector<char> buffer(RECEIVE_BUFFER_SIZE);
+	size_t bufferedBytes = 0;
+	int playingCount = matchesCount;
+	while(playingCount > 0)
+	{
+		if(!outgoing.empty())
+		{
+			if(!socket.SendAll(outgoing.data(), outgoing.size() * sizeof(Message)))
+				break;
+			outgoing.clear();
+		}
+
+		const int receivedBytes = socket.Receive(buffer.data() + bufferedBytes, buffer.size() - bufferedBytes);
+		if(receivedBytes <= 0)
+			break;
+		bufferedBytes += receivedBytes;
+
+		const steady_clock::time_point now = steady_clock::now();
+		const bool timeUp = now >= deadline;
+		const size_t messagesCount = bufferedBytes / sizeof(Message);
+		for(size_t i = 0; i < messagesCount; i++)
+		{
+			Message message;
+			memcpy(&message, buffer.data() + i * sizeof(Message), sizeof(Message));
+			const int m = (int)message.matchId;
+			if(m < 0 || m >= matchesCount)
+				continue;
+
+			Board & board = boards[m];
+			switch(message.type)
+			{
+				case MT_YourTurn:
+				{
+					stats.roundTripsMicros.push_back(duration<float, micro>(now - sentTimes[m]).count());
+					if(message.value > -1)
+						board.MakeMove(message.value, GetOpponentGlyph(glyphs[m]));
+
+					const vector<int> & emptyCells = board.GetEmptyCells();
+					const int cell = emptyCells[Random::Range(0, (int)emptyCells.size())];
+					board.MakeMove(cell, glyphs[m]);
+					outgoing.push_back(Message{ (uint32_t)m, (int16_t)cell, MT_Move, FG_None });
+					sentTimes[m] = now;
+					stats.moves++;
+					break;
+				}
+				case MT_MoveRejected:
+					//	The boards on both ends went out of sync, can't go on with this match
+					stats.rejectedMoves++;
+					playingCount--;
+					break;
+				case MT_GameOver:
+					stats.roundTripsMicros.push_back(duration<float, micro>(now - sentTimes[m]).count());
+					stats.games++;
+					if(message.glyph == FG_None)
+						stats.draws++;
+					else if(message.glyph == glyphs[m])
+						stats.remoteWins++;
+					else
+						stats.cpuWins++;
+
+					board.Reset();
+					if(timeUp)
+					{
+						playingCount--;
+						break;
+					}
+					outgoing.push_back(Message{ (uint32_t)m, 0, MT_NewMatch, (uint8_t)glyphs[m] });
+					sentTimes[m] = now;
+					break;
+				default:
+					break;
+			}
+		}
+
+		const size_t handledBytes = messagesCount * sizeof(Message);
+		memmove(buffer.data(), buffer.data() + handledBytes, bufferedBytes - handledBytes);
+		bufferedBytes -= handledBytes;
+	}
+
+	if(playingCount > 0)
+	{
+		cout << "Test client lost the connection with " << playingCount << " matches still going" << endl;
+		stats.failed = true;
+	}
+}
+
+void ReportTestClients(const vector<ClientStats> & clientsStats, double elapsedSeconds)
+{
+	ClientStats total{0, 0, 0, 0, 0, 0, vector<float>(), false};
+	for(const ClientStats & stats : clientsStats)
+	{
+		total.moves += stats.moves;
+		total.games += stats.games;
+		total.remoteWins += stats.remoteWins;
+		total.cpuWins += stats.cpuWins;
+		total.draws += stats.draws;
+		total.rejectedMoves += stats.rejectedMoves;
+		total.roundTripsMicros.insert(total.roundTripsMicros.end(), stats.roundTripsMicros.begin(), stats.roundTripsMicros.end());
+	}
+
+	cout << "Elapsed time: " << elapsedSeconds << " s" << endl;
+	cout << "Games played: " << total.games << " (" << (elapsedSeconds > 0.0 ? total.games / elapsedSeconds : 0.0) << " games/s)" << endl;
+	cout << "Moves played: " << total.moves << " (" << (elapsedSeconds > 0.0 ? total.moves / elapsedSeconds : 0.0) << " moves/s)" << endl;
+	cout << "CPU wins: " << total.cpuWins << ", remote wins: " << total.remoteWins << ", draws: " << total.draws << endl;
+	if(total.rejectedMoves > 0)
+		cout << "Rejected moves: " << total.rejectedMoves << endl;
+
+	vector<float> & roundTrips = total.roundTripsMicros;
+	if(roundTrips.empty())
+		return;
+
+	//	Percentiles, only the elements needed are put in place
+	const size_t p50 = roundTrips.size() / 2;
+	const size_t p99 = min(roundTrips.size() - 1, roundTrips.size() * 99 / 100);
+	nth_element(roundTrips.begin(), roundTrips.begin() + p50, roundTrips.end());
+	const float p50Micros = roundTrips[p50];
+	nth_element(roundTrips.begin(), roundTrips.begin() + p99, roundTrips.end());
+	const float p99Micros = roundTrips[p99];
+	const float maxMicros = *max_element(roundTrips.begin(), roundTrips.end());
+	cout << "Round trip: p50 " << p50Micros << " us, p99 " << p99Micros << " us, max " << maxMicros << " us" << endl;
+}
+
+Difficulty ParseDifficulty(int argc, char * argv[], const char * argCheck, Difficulty defaultDifficulty)
+{
+	/*
+	 * Iterate command line arguments and look for an argument
+	 * matching the argCheck parameter, followed by the name of
+	 * a difficulty.
+	 * If not found (or not valid), return the default difficulty.
+	 */
+	Difficulty difficulty = defaultDifficulty;
+	for(int a = 0; a < argc; a++)
+		if(
+			strcmp(argv[a], argCheck) == 0 &&
+			a < argc - 1
+		)
+		{
+			const char * const * name = find_if(begin(DifficultyNames), end(DifficultyNames), [&](const char * n) { return strcmp(n, argv[a + 1]) == 0; });
+			if(name != end(DifficultyNames))
+				difficulty = Difficulties[name - begin(DifficultyNames)];
+			else
+				cout << "Ignoring invalid difficulty: " << argv[a + 1] << endl;
+		}
+
+	return difficulty;
+}
@@ -0,0 +1,319 @@
+//	This tool has its own plain entry point, SDL is not initialized at all
+#define SDL_MAIN_HANDLED
+
+#pragma region C++ Includes
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#pragma endregion
+
+#pragma region Engine Includes
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#pragma endregion
+
+#pragma region Game Includes
+#include "Tokens.h"
+#include "CommandLine.h"
+#include "Board.h"
+#include "Bitboard.h"
+#include "Tablebase.h"
+#include "PerfectPlayTable.h"
+#pragma endregion
+
+using namespace std;
+using namespace std::chrono;
+
+/*
+ * Offline solver for the tablebases: it computes the value of
+ * every position of a board and writes it to a file the game
+ * maps in memory (see Tablebase).
+ *
+ * It works by retrograde analysis, with no search at all: a
+ * move always adds a glyph, so positions with more glyphs never
+ * lead back to positions with fewer. Layers of positions are
+ * solved from the full board down to the empty one, and by the
+ * time a position is met, every position its moves lead to is
+ * already solved, in the layer just above: solving it is just a
+ * matter of picking the best of them.
+ *
+ * Positions of a layer don't depend on each other, so a layer is
+ * split in chunks shared by all the cores. Chunks start on a byte
+ * of their own, and positions are walked in index order, so each
+ * core writes its bytes one after the other. The file is written
+ * through its mapping, so tables larger than the memory can be
+ * solved (the system writes pages out as needed), and the header
+ * only goes in at the end, so a file left halfway is refused.
+ *
+ * Sizes: the classic 3x3 board has 6 thousand positions, solved
+ * in no time and checked against the perfect play table; 4x4 has
+ * 10 million, 2.5 MB on disk; 5x5 has 162 billion, 40 GB on disk
+ * and hours on a workstation.
+ */
+
+#pragma region Constant Parameters
+//	Command line arguments
+#define CLI_KEY_BOARD "-board"	//	Followed by <columns>x<rows> or <columns>x<rows>x<run length>
+#define CLI_KEY_OUTPUT "--out"	//	Followed by the path of the tablebase to write, tablebase_<columns>x<rows>x<run length>.bin by default
+#define CLI_KEY_THREADS "--threads"	//	Followed by the number of threads, defaults to the number of cores
+
+//	Positions handed to a core at once, a multiple of four so chunks never share a byte
+#define CHUNK_POSITIONS (1 << 16)
+#pragma endregion
+
+/*
+ * The rules, as the solver needs them: every line of cells that
+ * wins the game, as masks, to tell the games already over.
+ */
+class TablebaseSolver
+{
+	// Fields
+public:
+protected:
+private:
+	BoardRules rules;
+	int cellsCount;
+	vector<TablebaseMask> runMasks;
+	vector<uint64_t> layerOffsets;
+	uint8_t * values = nullptr;
+	// Constructors
+public:
+	TablebaseSolver(const BoardRules & rules);
+protected:
+private:
+	// Methods
+public:
+	__inline uint64_t GetPositionsCount() const { return layerOffsets.back(); }
+	void SolveLayer(int glyphsCount, uint8_t * tableValues, ThreadPool & pool);
+	bool CheckClassic(const uint8_t * tableValues) const;
+protected:
+private:
+	void SolveChunk(int glyphsCount, uint64_t begin, uint64_t end);
+	TablebaseValue SolvePosition(int glyphsCount, TablebaseMask crossMask, TablebaseMask circleMask) const;
+	bool IsWon(TablebaseMask mask) const;
+};
+
+//	Forward declarations
+
+/*	ENTRY POINT	*/
+int main(int argc, char * argv[])
+{
+	BoardRules rules;
+	rules.columns = 4;
+	rules.rows = 4;
+	rules.runLength = 4;
+	rules = CommandLine::ParseBoardRules(argc, argv, CLI_KEY_BOARD, rules);
+	if(!Tablebase::IsSupported(rules))
+	{
+		cout << "Boards of more than " << Tablebase::MaxCellsCount << " cells are not supported" << endl;
+		return 1;
+	}
+
+	const string rulesName = to_string(rules.columns) + "x" + to_string(rules.rows) + "x" + to_string(rules.runLength);
+	const char * outputArg = CommandLine::FindArgValue(argc, argv, CLI_KEY_OUTPUT);
+	const string outputPath = outputArg ? outputArg : "tablebase_" + rulesName + ".bin";
+	ThreadPool pool(CommandLine::ParseCount(argc, argv, CLI_KEY_THREADS, 0));
+
+	TablebaseSolver solver(rules);
+	const TablebaseHeader header = Tablebase::MakeHeader(rules);
+	const uint64_t fileSize = sizeof(header) + (solver.GetPositionsCount() + 3) / 4;
+	cout << "Board " << rulesName << ": " << solver.GetPositionsCount() << " positions, " << fileSize << " bytes, on " << pool.GetWorkersCount() << " threads" << endl;
+
+	MappedFile file;
+	if(!file.Create(outputPath, (size_t)fileSize))
+	{
+		cout << "Can't write " << outputPath << endl;
+		return 1;
+	}
+
+	//	From the full board down to the empty one
+	uint8_t * tableValues = file.GetWritableData() + sizeof(header);
+	const steady_clock::time_point start = steady_clock::now();
+	const int cellsCount = rules.columns * rules.rows;
+	for(int glyphsCount = cellsCount; glyphsCount >= 0; glyphsCount--)
+	{
+		const steady_clock::time_point layerStart = steady_clock::now();
+		solver.SolveLayer(glyphsCount, tableValues, pool);
+		const double layerSeconds = duration_cast<duration<double>>(steady_clock::now() - layerStart).count();
+		cout << "Glyphs " << glyphsCount << ": " << Tablebase::GetLayerSize(cellsCount, glyphsCount) << " positions in " << layerSeconds << " s" << endl;
+	}
+	const double elapsedSeconds = duration_cast<duration<double>>(steady_clock::now() - start).count();
+
+	const TablebaseValue emptyBoardValue = Tablebase::GetValue(tableValues, 0);
+	cout << "Solved in " << elapsedSeconds << " s (" << (elapsedSeconds > 0.0 ? solver.GetPositionsCount() / elapsedSeconds : 0.0) << " positions/s)" << endl;
+	cout << "Empty board: " << (emptyBoardValue == TV_Win ? "the cross wins" : emptyBoardValue == TV_Loss ? "the circle wins" : "draw") << " with perfect play" << endl;
+
+	if(rules.columns == 3 && rules.rows == 3 && rules.runLength == 3)
+	{
+		if(!solver.CheckClassic(tableValues))
+			return 1;
+		cout << "Every position matches the perfect play table" << endl;
+	}
+
+	//	The file is only valid once complete
+	memcpy(file.GetWritableData(), &header, sizeof(header));
+	file.Close();
+	cout << "Saved to " << outputPath << endl;
+
+	return 0;
+}
+
+TablebaseSolver::TablebaseSolver(const BoardRules & rules) :
+	rules(rules),
+	cellsCount(rules.columns * rules.rows),
+	layerOffsets(Tablebase::GetLayerOffsets(rules))
+{
+	const Board board(rules);
+	for(int cell = 0; cell < cellsCount; cell++)
+		for(int direction = 0; direction < Board::DirectionsCount; direction++)
+		{
+			const int rowStep = Board::Directions[direction][0];
+			const int colStep = Board::Directions[direction][1];
+			const int row = board.GetRow(cell);
+			const int col = board.GetColumn(cell);
+			if(!board.IsInside(row + (rules.runLength - 1) * rowStep, col + (rules.runLength - 1) * colStep))
+				continue;
+
+			TablebaseMask runMask = 0;
+			for(int c = 0; c < rules.runLength; c++)
+				runMask |= (TablebaseMask)1 << board.ToCell(row + c * rowStep, col + c * colStep);
+
+			//	Runs of one cell are the same in every direction
+			if(find(runMasks.begin(), runMasks.end(), runMask) == runMasks.end())
+				runMasks.push_back(runMask);
+		}
+}
+
+void TablebaseSolver::SolveLayer(int glyphsCount, uint8_t * tableValues, ThreadPool & pool)
+{
+	values = tableValues;
+
+	const uint64_t layerSize = Tablebase::GetLayerSize(cellsCount, glyphsCount);
+	const uint64_t chunksCount = (layerSize + CHUNK_POSITIONS - 1) / CHUNK_POSITIONS;
+	atomic<uint64_t> nextChunk{0};
+	pool.Run([&](int)
+	{
+		for(uint64_t chunk = nextChunk++; chunk < chunksCount; chunk = nextChunk++)
+			SolveChunk(glyphsCount, chunk * CHUNK_POSITIONS, min(layerSize, (chunk + 1) * CHUNK_POSITIONS));
+	});
+}
+
+void TablebaseSolver::SolveChunk(int glyphsCount, uint64_t begin, uint64_t end)
+{
+	/*
+	 * Only the first position is found from its index, the next
+	 * ones follow in index order: the circles take the next
+	 * combination of the free cells, and once they're out of
+	 * combinations the crosses take theirs, with the circles
+	 * back at the first one.
+	 */
+	const int circlesCount = Tablebase::GetCirclesCount(glyphsCount);
+	const int freeCellsCount = cellsCount - Tablebase::GetCrossesCount(glyphsCount);
+	const uint64_t circleCombinations = Tablebase::GetBinomial(freeCellsCount, circlesCount);
+	const uint64_t fullMask = ((uint64_t)1 << cellsCount) - 1;
+
+	TablebaseMask crossMask;
+	TablebaseMask circleMask;
+	Tablebase::GetLayerMasks(cellsCount, glyphsCount, begin, crossMask, circleMask);
+	uint64_t circleRank = begin % circleCombinations;
+	TablebaseMask packedCircles = Tablebase::Compress(circleMask, (TablebaseMask)(fullMask & ~crossMask));
+
+	uint8_t * layerValues = values + layerOffsets[glyphsCount] / 4;
+	uint8_t packedValues = 0;
+	for(uint64_t index = begin; index < end; index++)
+	{
+		packedValues |= SolvePosition(glyphsCount, crossMask, circleMask) << ((index & 3) * 2);
+		if((index & 3) == 3 || index == end - 1)
+		{
+			layerValues[index >> 2] = packedValues;
+			packedValues = 0;
+		}
+
+		//	Next combination, with as many cells, as the next number with as many bits set
+		if(++circleRank < circleCombinations)
+		{
+			const uint64_t lowestBit = packedCircles & (~(uint64_t)packedCircles + 1);
+			const uint64_t carried = packedCircles + lowestBit;
+			packedCircles = (TablebaseMask)((((carried ^ packedCircles) >> 2) / lowestBit) | carried);
+		}
+		else if(index + 1 < end)
+		{
+			const uint64_t lowestBit = crossMask & (~(uint64_t)crossMask + 1);
+			const uint64_t carried = crossMask + lowestBit;
+			crossMask = (TablebaseMask)((((carried ^ crossMask) >> 2) / lowestBit) | carried);
+			circleRank = 0;
+			packedCircles = (TablebaseMask)(((uint64_t)1 << circlesCount) - 1);
+		}
+		circleMask = Tablebase::Expand(packedCircles, (TablebaseMask)(fullMask & ~crossMask));
+	}
+}
+
+TablebaseValue TablebaseSolver::SolvePosition(int glyphsCount, TablebaseMask crossMask, TablebaseMask circleMask) const
+{
+	//	Game already won, by the faction that moved last: the faction to move has lost
+	if(IsWon(crossMask) || IsWon(circleMask))
+		return TV_Loss;
+
+	//	Game over with a draw
+	if(glyphsCount == cellsCount)
+		return TV_Draw;
+
+	//	The best of the moves, each one leading to a position of the next layer, seen from the opponent
+	const bool crossToMove = Tablebase::GetCrossesCount(glyphsCount) == Tablebase::GetCirclesCount(glyphsCount);
+	const uint64_t nextLayerOffset = layerOffsets[glyphsCount + 1];
+	TablebaseValue bestValue = TV_Loss;
+	for(uint64_t freeCells = (((uint64_t)1 << cellsCount) - 1) & ~(uint64_t)(crossMask | circleMask); freeCells; freeCells &= freeCells - 1)
+	{
+		const TablebaseMask cellBit = (TablebaseMask)(freeCells & (~freeCells + 1));
+		const TablebaseMask nextCrossMask = crossToMove ? crossMask | cellBit : crossMask;
+		const TablebaseMask nextCircleMask = crossToMove ? circleMask : circleMask | cellBit;
+		const TablebaseValue opponentValue = Tablebase::GetValue(values, nextLayerOffset + Tablebase::GetLayerIndex(cellsCount, nextCrossMask, nextCircleMask));
+		const TablebaseValue value = (TablebaseValue)(TV_Win - opponentValue);
+		if(value > bestValue)
+		{
+			bestValue = value;
+			if(bestValue == TV_Win)
+				break;
+		}
+	}
+
+	return bestValue;
+}
+
+bool TablebaseSolver::IsWon(TablebaseMask mask) const
+{
+	for(const TablebaseMask runMask : runMasks)
+		if((mask & runMask) == runMask)
+			return true;
+
+	return false;
+}
+
+bool TablebaseSolver::CheckClassic(const uint8_t * tableValues) const
+{
+	//	Both tables see positions from the faction to move, the sign of the score tells the value
+	for(int glyphsCount = 0; glyphsCount <= cellsCount; glyphsCount++)
+		for(uint64_t index = 0; index < Tablebase::GetLayerSize(cellsCount, glyphsCount); index++)
+		{
+			TablebaseMask crossMask;
+			TablebaseMask circleMask;
+			Tablebase::GetLayerMasks(cellsCount, glyphsCount, index, crossMask, circleMask);
+
+			const int score = PerfectPlayTable::Lookup(Bitboard((CellsMask)crossMask, (CellsMask)circleMask)).score;
+			const TablebaseValue expectedValue = score > 0 ? TV_Win : score < 0 ? TV_Loss : TV_Draw;
+			if(Tablebase::GetValue(tableValues, layerOffsets[glyphsCount] + index) != expectedValue)
+			{
+				cout << "Mismatch with the perfect play table, crosses " << crossMask << ", circles " << circleMask << endl;
+				return false;
+			}
+		}
+
+	return true;
+}